@@ -17,11 +17,19 @@
 #include "OS/OS_Core/OS_Scheduler.h"
 #include "OS/OS_Core/OS_Sem.h"
 #include "OS/OS_Core/OS_Mutex.h"
+#include "OS/OS_Core/OS_RWLock.h"
+#include "OS/OS_Core/OS_Cond.h"
+#include "OS/OS_Core/OS_WorkQ.h"
 #include "OS/OS_Core/OS_Event.h"
 #include "OS/OS_Core/OS_MsgQ.h"
+#include "OS/OS_Core/OS_Mailbox.h"
+#include "OS/OS_Core/OS_Stream.h"
+#include "OS/OS_Core/OS_WaitSet.h"
 #include "OS/OS_Core/OS_Topic.h"
 #include "OS/OS_Core/OS_Process.h"
+#include "OS/OS_Core/OS_Xip.h"
 #include "OS/OS_Core/OS_Syscalls.h"
+#include "OS/OS_Core/OS_KData.h"
 
 /**********************************************
  * PUBLIC FUNCTIONS
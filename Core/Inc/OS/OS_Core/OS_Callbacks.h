@@ -43,7 +43,8 @@ void os_task_on_block_cb(os_handle_t h);
 /***********************************************************************
  * OS Idle task main funciton
  *
- * @brief This function is executed when the idle task is called (i.e) no other task is available
+ * @brief This function is executed when the idle task is called (i.e) no other task is available.
+ * It frees the tasks that deleted themselves; an override should call os_task_reap as well (task creations only free a few).
  *
  * @return : void* : generic return value
  *
@@ -72,4 +73,18 @@ void os_no_task_ready_cb();
  **********************************************************************/
 void os_insufficient_heap_cb();
 
+
+/***********************************************************************
+ * OS Stack Overflow Callback
+ *
+ * @brief This function is called by the OS when the running task reached its stack guard (see OS_STACK_GUARD_EN).
+ * The fault handler halts once it returns
+ *
+ * ATTENTION : This function is called in fault context (MemManage or HardFault), the OS services cannot be used
+ *
+ * @param os_handle_t h : [in] Task that overflowed its stack
+ *
+ **********************************************************************/
+void os_stack_overflow_cb(os_handle_t h);
+
 #endif /* INC_OS_OS_CALLBACKS_H_ */
@@ -0,0 +1,111 @@
+/*
+ * OS_Cond.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_COND_H_
+#define INC_OS_OS_COND_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Condition variable object (useful to cast from handle to condition variable)
+ ---------------------------------------------------*/
+typedef struct os_cond_{
+	os_obj_t 		obj; 			//MUST BE FIRST MEMBER. Object base structure
+	uint32_t		pending;		//Number of wake ups given to the waiting tasks and not consumed yet
+} os_cond_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Condition Variable Create
+ *
+ * @brief This function creates a condition variable. Signals sent while nobody waits are lost.
+ *
+ * @param os_handle_t* h 	: [out] handle to condition variable
+ * @param char* name		: [ in] condition variable name. If one with the same name already exists, its reference is returned. A null name always creates a nameless condition variable.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_create(os_handle_t* h, char const * name);
+
+
+/***********************************************************************
+ * OS Condition Variable Wait
+ *
+ * @brief This function releases the mutex and blocks on the condition variable atomically, then takes the mutex back before returning
+ * (even on timeout). The mutex must be owned by the calling task. As with any condition variable, the predicate must be checked again after waking up.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the condition variable
+ * @param os_handle_t mutex 		: [ in] Handle to the mutex protecting the predicate
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait for a signal. OS_WAIT_FOREVER is accepted
+ *
+ * @return os_err_e OS_ERR_OK if signaled, OS_ERR_TIMEOUT if not signaled in time
+ **********************************************************************/
+os_err_e os_cond_wait(os_handle_t h, os_handle_t mutex, uint32_t timeout_ticks);
+
+
+/***********************************************************************
+ * OS Condition Variable Signal
+ *
+ * @brief This function wakes up the highest priority task waiting for the condition variable, if any
+ *
+ * @param os_handle_t h : [ in] Handle to the condition variable
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_signal(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Condition Variable Broadcast
+ *
+ * @brief This function wakes up every task waiting for the condition variable
+ *
+ * @param os_handle_t h : [ in] Handle to the condition variable
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_broadcast(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Condition Variable delete
+ *
+ * @brief This function deletes a condition variable. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the condition variable
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_delete(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Get Condition Variable from handle
+ *
+ * @brief This function gets the condition variable object from the handle
+ *
+ * @param os_handle_t h : [ in] Pointer to the condition variable
+ *
+ * @return os_cond_t* : NULL if error, the condition variable reference if OK
+ **********************************************************************/
+static inline os_cond_t* os_cond_getFromHandle(os_handle_t h){
+	if(h == NULL) return NULL;
+	if(h->type != OS_OBJ_COND) return NULL;
+
+	return (os_cond_t*)h;
+}
+
+
+#endif /* INC_OS_OS_COND_H_ */
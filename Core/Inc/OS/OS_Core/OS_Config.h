@@ -26,12 +26,28 @@
  ---------------------------------------------------*/
 #define OS_FPU_EN								1
 
+/* Enables the stack guard of the Cortex-M4 port (the M33 port uses PSPLIM) : a no access MPU region at the bottom of the
+ * running task's stack, so an overflow faults right away and is reported by os_stack_overflow_cb. The guard takes the lowest
+ * OS_STACK_GUARD_SIZE to 2 * OS_STACK_GUARD_SIZE - 8 bytes of each stack. The size must be a power of 2, 32 at least.
+ * ATTENTION : the guard only catches overflows that touch it. A function whose frame is bigger than the guard (e.g. a local
+ * char buffer[256]) can step over it and write below the stack unnoticed. The default 32 bytes catches the exception frame
+ * and small frames only; raise it above the biggest frame of the application (stacks must stay larger than 2 * size)
+ ---------------------------------------------------*/
+#define OS_STACK_GUARD_EN						1
+#define OS_STACK_GUARD_SIZE						32
+
 
 /* This define controls the size of the default function stack in bytes
  * It is recommended to have a multiple of 4
  ---------------------------------------------------*/
 #define OS_DEFAULT_STACK_SIZE					1024
 
+
+/* Maximum number of self-deleted tasks (zombies) freed by each task creation before allocating the new task. The idle task
+ * frees the rest, this bounds the leak when the idle task never runs or a custom os_idle_task_fn does not call os_task_reap
+ ---------------------------------------------------*/
+#define OS_TASK_REAP_ON_CREATE					2
+
 /**************************************************
  * HEAP CONFIGURATIONS
  *************************************************/
@@ -50,4 +66,62 @@
 #define OS_HEAP_BIG_BLOCK_THRESHOLD				50
 
 
+/**************************************************
+ * MESSAGE QUEUE CONFIGURATIONS
+ *************************************************/
+
+/* Number of message priorities of a priority message queue (OS_MSGQ_MODE_PRIO)
+ * Priorities go from 0 (lowest) to OS_MSGQ_PRIO_LEVELS - 1 (highest). Maximum is 32
+ ---------------------------------------------------*/
+#define OS_MSGQ_PRIO_LEVELS						32
+
+
+/**************************************************
+ * PROCESS CONFIGURATIONS
+ *************************************************/
+
+/* Priority of a process main thread when its executable does not request one, and highest priority it may request
+ * (kernel workers run above it)
+ ---------------------------------------------------*/
+#define OS_PROCESS_DEFAULT_PRIO					40
+#define OS_PROCESS_MAX_PRIO						79
+
+
+/* Size of the arena of each process left for its own allocations (os_heap_alloc calls from the process).
+ * The arena also holds the process image, its main stack and its arguments
+ ---------------------------------------------------*/
+#define OS_PROCESS_HEAP_SIZE					(4 * 1024)
+
+
+/* Default limits of a process (see os_process_setLimits) : bytes it may allocate with os_heap_alloc (0 = up to its arena),
+ * share of each accounting window it may run at its own priority in % (100 = no limit) and number of threads
+ ---------------------------------------------------*/
+#define OS_PROCESS_HEAP_QUOTA					0
+#define OS_PROCESS_CPU_SHARE					100
+#define OS_PROCESS_MAX_THREADS					4
+
+
+/* Length of the CPU accounting window, and priority a process is demoted to for the rest of the window once it used its share
+ * (above the idle task, so it still runs when nothing else is ready)
+ ---------------------------------------------------*/
+#define OS_PROCESS_CPU_WINDOW_MS				1000
+#define OS_PROCESS_THROTTLE_PRIO				1
+
+
+/* Priority and stack size of the kernel worker loading the processes created with os_process_createAsync
+ ---------------------------------------------------*/
+#define OS_PROCESS_LOADER_PRIO					30
+#define OS_PROCESS_LOADER_STACK_SIZE			(2 * OS_DEFAULT_STACK_SIZE)
+
+
+/**************************************************
+ * FILE SYSTEM CONFIGURATIONS
+ *************************************************/
+
+/* Priority and stack size of the kernel worker executing the I/O ring batches
+ ---------------------------------------------------*/
+#define OS_FS_RING_WORKER_PRIO					100
+#define OS_FS_RING_WORKER_STACK_SIZE			(2 * OS_DEFAULT_STACK_SIZE)
+
+
 #endif /* INC_OS_OS_CONFIG_H_ */
@@ -10,6 +10,12 @@
 
 #include "OS/OS_Core/OS_Common.h"
 
+/**********************************************
+ * DEFINES
+ *********************************************/
+
+#define OS_HEAP_BLOCK_HEADER_SIZE		8	//Bytes taken by the header of each allocated block
+
 /**********************************************
  * PUBLIC TYPES
  *********************************************/
@@ -21,6 +27,8 @@ typedef struct{
 	uint32_t fragmented_size;		//The size in bytes of all fragmented blocks (a fragmented block is a free block between two used blocks)
 } os_heap_mon_t; //Heap Monitor structure
 
+typedef struct os_heap_arena_ os_heap_arena_t; //Heap sub-region serving a single owner
+
 /**********************************************
  * PUBLIC FUNCTIONS
  *********************************************/
@@ -50,7 +58,7 @@ void* os_heap_alloc(uint32_t size);
 /***********************************************************************
  * OS Heap Free
  *
- * @brief This function frees a memory block previously allocated my OS_Heap_Alloc
+ * @brief This function frees a memory block previously allocated my OS_Heap_Alloc or os_heap_arenaAlloc
  *
  * @param void* p : [in] Pointer to the data as given by Alloc
  *
@@ -69,4 +77,66 @@ os_err_e os_heap_free(void* p);
 os_heap_mon_t os_heap_monitor();
 
 
+/***********************************************************************
+ * OS Heap Arena Create
+ *
+ * @brief This function reserves a block of the heap to serve the allocations of a single owner
+ *
+ * @param uint32_t size : [in] Amount of bytes the arena can serve (block headers included, 8 bytes per allocation)
+ *
+ * @return os_heap_arena_t* : the arena, NULL if there is not enough memory
+ **********************************************************************/
+os_heap_arena_t* os_heap_arenaCreate(uint32_t size);
+
+
+/***********************************************************************
+ * OS Heap Arena Alloc
+ *
+ * @brief This function allocates an amount of bytes into an arena. The block is freed with os_heap_free, or when the arena is deleted
+ *
+ * @param os_heap_arena_t* a 	: [in] Arena
+ * @param uint32_t size 		: [in] Size to be allocated
+ *
+ * @return void* : Address of the memory block or NULL if the function failed (bad argument or not enough memory in the arena)
+ **********************************************************************/
+void* os_heap_arenaAlloc(os_heap_arena_t* a, uint32_t size);
+
+
+/***********************************************************************
+ * OS Heap Arena Monitor
+ *
+ * @brief This function returns data about an arena's utilization
+ *
+ * @param os_heap_arena_t* a : [in] Arena
+ *
+ * @return os_heap_mon_t : Struct containing arena info
+ **********************************************************************/
+os_heap_mon_t os_heap_arenaMonitor(os_heap_arena_t* a);
+
+
+/***********************************************************************
+ * OS Heap Arena Block Size
+ *
+ * @brief This function gets the size of a block allocated in an arena
+ *
+ * @param os_heap_arena_t* a 	: [in] Arena
+ * @param void const* p 		: [in] Address given by os_heap_arenaAlloc
+ *
+ * @return uint32_t : Size of the block (header included), 0 if p is not an allocated block of the arena
+ **********************************************************************/
+uint32_t os_heap_arenaBlockSize(os_heap_arena_t* a, void const* p);
+
+
+/***********************************************************************
+ * OS Heap Arena Delete
+ *
+ * @brief This function gives an arena back to the heap, with every block still allocated in it
+ *
+ * @param os_heap_arena_t* a : [in] Arena
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_heap_arenaDelete(os_heap_arena_t* a);
+
+
 #endif /* INC_OS_OS_HEAP_H_ */
@@ -62,6 +62,34 @@ typedef enum{
 void os_obj_updatePrio(os_handle_t h);
 
 
+//////////////////////////////////////////////// FAST PATHS //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Mutex fast take
+ *
+ * @brief This function takes a free mutex nobody is waiting for without going through the generic wait.
+ * The mutex is not added to the owner's owned list: os_mutex_udpatePrio does it if a task ever blocks on it.
+ *
+ * @param os_handle_t h : [in] mutex to take
+ *
+ * @return bool : 1 = mutex taken; 0 = the slow path must be used
+ **********************************************************************/
+bool os_mutex_fastTake(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Semaphore fast take
+ *
+ * @brief This function decrements a semaphore nobody is waiting for without going through the generic wait.
+ *
+ * @param os_handle_t h : [in] semaphore to take
+ *
+ * @return bool : 1 = semaphore taken; 0 = the slow path must be used
+ **********************************************************************/
+bool os_sem_fastTake(os_handle_t h);
+
+
 //////////////////////////////////////////////// TASKS //////////////////////////////////////////////////
 
 
@@ -92,6 +120,20 @@ os_err_e os_task_init(char* main_name, int8_t main_task_priority, uint32_t inter
 bool os_task_must_yeild();
 
 
+//////////////////////////////////////////////// WAIT-SETS //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Wait-set detach
+ *
+ * @brief This function unregisters an object from its wait-set, if any. Every delete function calls it
+ * so that a wait-set never keeps a pointer to a freed object.
+ *
+ * @param os_handle_t obj : [in] object being deleted
+ **********************************************************************/
+void os_waitset_detach(os_handle_t obj);
+
+
 //////////////////////////////////////////////// HANDLE LISTS //////////////////////////////////////////////////
 
 /***********************************************************************
@@ -246,5 +288,42 @@ bool os_task_list_isObjFreeOnTask(os_handle_t obj, os_handle_t task);
 bool os_handle_list_updateAndCheck(os_handle_t h);
 
 
+//////////////////////////////////////////////// KERNEL DATA //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Kernel Data Set Tick
+ *
+ * @brief This function publishes the tick counter. Must be called with interrupts disabled
+ *
+ * @param uint32_t msTick : [in] Tick counter in ms
+ **********************************************************************/
+void os_kdata_setTick(uint32_t msTick);
+
+
+/***********************************************************************
+ * OS Kernel Data Set Task
+ *
+ * @brief This function publishes the task chosen by the scheduler. Must be called with interrupts disabled
+ *
+ * @param os_handle_t task : [in] Task about to run
+ **********************************************************************/
+void os_kdata_setTask(os_handle_t task);
+
+
+//////////////////////////////////////////////// PROCESS //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Process Tick
+ *
+ * @brief This function charges the tick to the process of the running task, throttles the processes exceeding their CPU share
+ * and closes the accounting window when it elapsed. Must be called with interrupts disabled
+ *
+ * @param uint32_t ms_inc : [in] Amount of ms elapsed
+ **********************************************************************/
+void os_process_tick(uint32_t ms_inc);
+
+
 
 #endif /* INC_OS_OS_INTERNAL_H_ */
@@ -0,0 +1,99 @@
+/*
+ * OS_KData.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_KDATA_H_
+#define INC_OS_OS_KDATA_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Kernel data page. Written by the kernel (tick and context switch interrupts), read by processes with plain loads.
+ * It is read-only to processes by convention only: processes run privileged and no MPU region protects the page,
+ * so a stray write from a process corrupts it silently. Processes must only access it through the const pointer.
+ * A process receives its address as the third argument of its entry point: int main(int argc, char* argv[], os_kdata_t const* kd)
+ ---------------------------------------------------*/
+typedef struct os_kdata_{
+	uint32_t volatile		seq;			//Sequence counter. Odd while the kernel writes the page
+	uint32_t volatile		msTick;			//Tick counter in ms (same as os_getMsTick)
+	os_handle_t volatile	curTask;		//Task running
+	uint16_t volatile		curPID;			//PID of the process owning the running task, 0 for kernel tasks
+	uint32_t volatile		ctxSwitches;	//Number of context switches done by the scheduler
+	uint32_t volatile		nTasks;			//Number of tasks in the system
+} os_kdata_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Kernel Data Get
+ *
+ * @brief This function returns the kernel data page
+ *
+ * @return os_kdata_t const* : reference to the page
+ **********************************************************************/
+os_kdata_t const* os_kdata_get();
+
+
+/***********************************************************************
+ * OS Kernel Data Snapshot
+ *
+ * @brief This function copies a consistent view of the kernel data page, reading it again if the kernel updated it meanwhile
+ *
+ * @param os_kdata_t const* kd 	: [ in] Kernel data page
+ * @param os_kdata_t* out 		: [out] Copy of the page
+ **********************************************************************/
+static inline void os_kdata_snapshot(os_kdata_t const* kd, os_kdata_t* out){
+	uint32_t seq;
+
+	do {
+		seq 				= kd->seq;
+		out->msTick 		= kd->msTick;
+		out->curTask 		= kd->curTask;
+		out->curPID 		= kd->curPID;
+		out->ctxSwitches 	= kd->ctxSwitches;
+		out->nTasks 		= kd->nTasks;
+	} while( (seq & 1) != 0 || seq != kd->seq );
+
+	out->seq = seq;
+}
+
+
+/***********************************************************************
+ * OS Kernel Data Get Tick
+ *
+ * @brief This function reads the tick counter from the kernel data page
+ *
+ * @param os_kdata_t const* kd : [in] Kernel data page
+ *
+ * @return uint32_t : the tick counter in ms
+ **********************************************************************/
+static inline uint32_t os_kdata_getMsTick(os_kdata_t const* kd){
+	return kd->msTick;
+}
+
+
+/***********************************************************************
+ * OS Kernel Data Get PID
+ *
+ * @brief This function reads the PID of the running process from the kernel data page. Called by a process, it is its own PID
+ *
+ * @param os_kdata_t const* kd : [in] Kernel data page
+ *
+ * @return uint16_t : the PID, 0 for kernel tasks
+ **********************************************************************/
+static inline uint16_t os_kdata_getPID(os_kdata_t const* kd){
+	return kd->curPID;
+}
+
+
+#endif /* INC_OS_OS_KDATA_H_ */
@@ -0,0 +1,115 @@
+/*
+ * OS_Mailbox.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_MAILBOX_H_
+#define INC_OS_OS_MAILBOX_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Mailbox object (useful to cast from handle to mailbox)
+ ---------------------------------------------------*/
+typedef struct os_mbox_{
+	os_obj_t 		obj; 			//MUST BE FIRST MEMBER. Object base structure
+	void*	 		msg;			//Last message posted
+	uint32_t		seq;			//Sequence number of the last message posted (0 = nothing posted yet)
+	bool			unread;			//Indicates if the last message was not read yet
+} os_mbox_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Mailbox Create
+ *
+ * @brief This function creates a one-slot mailbox. A new post always overwrites the previous message, read or not.
+ *
+ * @param os_handle_t* h 	: [out] handle to mailbox
+ * @param char* name		: [ in] mailbox name. If a mailbox with the same name already exists, its reference is returned. A null name always creates a nameless mailbox.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mbox_create(os_handle_t* h, char const * name);
+
+
+/***********************************************************************
+ * OS Mailbox Post
+ *
+ * @brief This function overwrites the mailbox message and increments its sequence number. Never allocates, so it can be called from interrupts.
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ * @param void* msg     : [ in] Reference to the message
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mbox_post(os_handle_t h, void* msg);
+
+
+/***********************************************************************
+ * OS Mailbox Read
+ *
+ * @brief This function reads the newest message of the mailbox and marks it as read
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ * @param uint32_t* seq : [out] Sequence number of the message read. NULL to ignore
+ * @param os_err_e* err : [out] Reference to the error code. OS_ERR_EMPTY if there is no unread message. NULL to ignore
+ *
+ * @return void* : the message or NULL if error
+ **********************************************************************/
+void* os_mbox_read(os_handle_t h, uint32_t* seq, os_err_e* err);
+
+
+/***********************************************************************
+ * OS Mailbox Peek
+ *
+ * @brief This function reads the newest message of the mailbox without marking it as read
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ * @param uint32_t* seq : [out] Sequence number of the message. NULL to ignore
+ * @param os_err_e* err : [out] Reference to the error code. OS_ERR_EMPTY if nothing was ever posted. NULL to ignore
+ *
+ * @return void* : the message or NULL if error
+ **********************************************************************/
+void* os_mbox_peek(os_handle_t h, uint32_t* seq, os_err_e* err);
+
+
+/***********************************************************************
+ * OS Mailbox delete
+ *
+ * @brief This function deletes a mailbox. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mbox_delete(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Get Mailbox from handle
+ *
+ * @brief This function gets the mailbox object from the handle
+ *
+ * @param os_handle_t h : [ in] Pointer to the mailbox
+ *
+ * @return os_mbox_t* : NULL if error, the mailbox reference if OK
+ **********************************************************************/
+static inline os_mbox_t* os_mbox_getFromHandle(os_handle_t h){
+	if(h == NULL) return NULL;
+	if(h->type != OS_OBJ_MBOX) return NULL;
+
+	return (os_mbox_t*)h;
+}
+
+
+#endif /* INC_OS_OS_MAILBOX_H_ */
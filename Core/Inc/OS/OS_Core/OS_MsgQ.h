@@ -11,6 +11,14 @@
 #include "OS/OS_Core/OS_Common.h"
 #include "OS/OS_Core/OS_Obj.h"
 
+/**********************************************
+ * DEFINES
+ *********************************************/
+
+#if OS_MSGQ_PRIO_LEVELS < 1 || OS_MSGQ_PRIO_LEVELS > 32
+#error "OS_MSGQ_PRIO_LEVELS must be between 1 and 32"
+#endif
+
 /**********************************************
  * PUBLIC TYPES
  *********************************************/
@@ -20,6 +28,7 @@
 typedef enum{
 	OS_MSGQ_MODE_FIFO,
 	OS_MSGQ_MODE_LIFO,
+	OS_MSGQ_MODE_PRIO,
 	__OS_MSGQ_MODE_INVALID
 } os_msgQ_mode_e;
 
@@ -27,8 +36,11 @@ typedef enum{
  ---------------------------------------------------*/
 typedef struct os_msgQ_{
 	os_obj_t 		obj; 			//MUST BE FIRST MEMBER. Object base structure
-	void*	 		msgList;		//List containing all messages
-	os_msgQ_mode_e	mode;			//Message queue mode (FIFO or LIFO)
+	void*	 		msgList;		//List containing all messages (FIFO or LIFO)
+	os_msgQ_mode_e	mode;			//Message queue mode (FIFO, LIFO or PRIO)
+	void**			prioList;		//One FIFO list per message priority, allocated on first use (PRIO only)
+	uint32_t		prioBitmap;		//Bit n is set when prioList[n] is not empty (PRIO only)
+	uint32_t		prioMsgCount;	//Number of messages in all priority lists (PRIO only)
 } os_msgQ_t;
 
 /**********************************************
@@ -42,7 +54,7 @@ typedef struct os_msgQ_{
  * @brief This function creates a message queue
  *
  * @param os_handle_t* msgQ 	: [out] handle to msgQ
- * @param os_msgQ_mode_e mode 	: [ in] The queue's mode: FIFO or LIFO
+ * @param os_msgQ_mode_e mode 	: [ in] The queue's mode: FIFO, LIFO or PRIO (highest message priority first, FIFO among equal priorities)
  * @param char* name			: [ in] messqge Q name. If a queue with the same name already exists, its reference is returned. A null name always creates a nameless queue.
  *
  * @return os_err_e OS_ERR_OK if OK
@@ -63,10 +75,24 @@ os_err_e os_msgQ_create(os_handle_t* msgQ, os_msgQ_mode_e mode, char const * nam
 os_err_e os_msgQ_push(os_handle_t h, void* msg);
 
 
+/***********************************************************************
+ * OS MsgQ Push with priority
+ *
+ * @brief This function pushes a message with a given priority. The priority is ignored if the queue is not in PRIO mode
+ *
+ * @param os_handle_t h : [ in] Handle to the queue
+ * @param void* msg     : [ in] Reference to the message
+ * @param uint8_t prio  : [ in] Message priority, from 0 (lowest) to OS_MSGQ_PRIO_LEVELS - 1 (highest)
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_msgQ_push_prio(os_handle_t h, void* msg, uint8_t prio);
+
+
 /***********************************************************************
  * OS MsgQ Pop
  *
- * @brief This function pops a message from the queue
+ * @brief This function pops a message from the queue. In PRIO mode, the oldest message with the highest priority is returned
  *
  * @param os_handle_t h : [ in] Handle to the queue
  * @param os_err_e* err : [out] Reference to the error message. NULL to ignore
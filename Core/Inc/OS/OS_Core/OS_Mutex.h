@@ -30,6 +30,8 @@ typedef struct os_mutex_{
 	os_handle_t			owner;  	//Handle to the owner task
 	os_mutex_state_e 	state;		//State of the mutex
 	int8_t				max_prio;	//Store maximum priority
+	bool				ownerListed;//Indicates if the mutex is in the owner's owned mutex list (delayed until contention when taken through the fast path)
+	int8_t				ceiling;	//Priority ceiling (-1 = priority inheritance)
 } os_mutex_t;
 
 /**********************************************
@@ -49,6 +51,22 @@ typedef struct os_mutex_{
 os_err_e os_mutex_create(os_handle_t* h, char const * name);
 
 
+/***********************************************************************
+ * OS Mutex Create Ceiling
+ *
+ * @brief This function creates a mutex using the immediate priority ceiling protocol.
+ * The owner runs at least at the ceiling priority while it holds the mutex, and waiters never lend their priority.
+ * The ceiling must be at least the priority of every task using the mutex.
+ *
+ * @param os_handle_t* h 		: [out] handle to mutex
+ * @param int8_t ceiling_prio	: [ in] Ceiling priority (0 to 127)
+ * @param char* name			: [ in] Mutex's name. If a mutex with the same name already exists, its reference is returned. A null name always creates a nameless mutex.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mutex_create_ceiling(os_handle_t* h, int8_t ceiling_prio, char const * name);
+
+
 /***********************************************************************
  * OS Mutex Release
  *
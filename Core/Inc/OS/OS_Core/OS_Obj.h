@@ -35,7 +35,13 @@ typedef enum{
 	OS_OBJ_SEM,
 	OS_OBJ_EVT,
 	OS_OBJ_MSGQ,
-	OS_OBJ_TOPIC
+	OS_OBJ_TOPIC,
+	OS_OBJ_MBOX,
+	OS_OBJ_STREAM,
+	OS_OBJ_WAITSET,
+	OS_OBJ_RWLOCK,
+	OS_OBJ_COND,
+	OS_OBJ_WORKQ
 }os_obj_type_e;
 
 
@@ -54,6 +60,7 @@ typedef struct os_obj_{
 	uint32_t 		(*getFreeCount) (os_handle_t h, os_handle_t takingTask);		//Function to get the freecount
 	os_err_e 		(*obj_take) 	(os_handle_t h, os_handle_t takingTask);		//Function to take the object
 	void* 			blockList;														//Blocked list head (tasks waiting for this object are listed here)
+	struct os_obj_*	waitSet;														//Wait-set notified when this object changes (NULL if none)
 }os_obj_t;
 
 
@@ -71,6 +78,12 @@ typedef struct os_obj_{
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @param os_handle_t obj  		 : [ in] Handle of the object to wait
  * @param uint32_t timeout_ticks : [ in] Amount of time before a timeout is detected. If OS_WAIT_FOREVER, the task blocks forever. If OS_WAIT_NONE, the task returns imediately
@@ -91,6 +104,12 @@ os_handle_t os_obj_single_wait(os_handle_t obj, uint32_t timeout_ticks, os_err_e
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @parem os_err_e* err			 : [out] Error code. Ignored if NULL.
  * @param uint32_t timeout_ticks : [ in] Amount of time before a timeout is detected. If OS_WAIT_FOREVER, the task blocks forever. If OS_WAIT_NONE, the task returns immediately
@@ -112,6 +131,12 @@ os_handle_t os_obj_multiple_WaitAll(os_err_e* err, uint32_t timeout_ticks, size_
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @parem os_err_e* err			 : [out] Error code. Ignored if NULL.
  * @param uint32_t timeout_ticks : [ in] Amount of time before a timeout is detected. If OS_WAIT_FOREVER, the task blocks forever. If OS_WAIT_NONE, the task returns immediately
@@ -133,6 +158,12 @@ os_handle_t os_obj_multiple_WaitOne(os_err_e* err, uint32_t timeout_ticks, size_
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @param os_handle_t objList[]  : [ in] Array containing all objects to wait
  * @param size_t objNum			 : [ in] number of objects to wait
@@ -154,6 +185,12 @@ os_handle_t os_obj_multiple_lWaitAll(os_handle_t objList[], size_t objNum, uint3
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @param os_handle_t objList[]  : [ in] Array containing all objects to wait
  * @param size_t objNum			 : [ in] number of objects to wait
@@ -175,6 +212,12 @@ os_handle_t os_obj_multiple_lWaitOne(os_handle_t objList[], size_t objNum, uint3
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @parem os_err_e* err			 : [out] Error code. Ignored if NULL.
  * @param uint32_t timeout_ticks : [ in] Amount of time before a timeout is detected. If OS_WAIT_FOREVER, the task blocks forever. If OS_WAIT_NONE, the task returns immediately
@@ -196,6 +239,12 @@ os_handle_t os_obj_multiple_vWaitAll(os_err_e* err, uint32_t timeout_ticks, size
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_MBOX  : The mailbox holds an unread message
+ * OS_OBJ_STREAM: The stream holds at least its trigger level in bytes
+ * OS_OBJ_WAITSET: At least one object registered in the wait-set is available
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task (read unless set by os_rwlock_writeLock)
+ * OS_OBJ_COND  : The condition variable was signaled while the task was waiting for it
+ * OS_OBJ_WORKQ : Every work submitted to the queue is done
 
  * @parem os_err_e* err			 : [out] Error code. Ignored if NULL.
  * @param uint32_t timeout_ticks : [ in] Amount of time before a timeout is detected. If OS_WAIT_FOREVER, the task blocks forever. If OS_WAIT_NONE, the task returns immediately
@@ -10,6 +10,62 @@
 
 #include <stdarg.h>
 #include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+#include "OS/OS_Core/OS_Heap.h"
+
+/**********************************************
+ * DEFINES
+ *********************************************/
+
+/* ELF program header types and flags
+ ---------------------------------------------------*/
+#define OS_ELF_PT_LOAD				1		//Loadable segment
+#define OS_ELF_PF_W					0x2		//Segment is writable
+
+/* Maximum number of LOAD segments in a program
+ ---------------------------------------------------*/
+#define OS_ELF_MAP_MAX				4
+
+/* ELF section types and flags
+ ---------------------------------------------------*/
+#define OS_ELF_SHT_NOTE				7		//Notes
+#define OS_ELF_SHT_REL				9		//Relocation entries, no addends
+#define OS_ELF_SHF_ALLOC			0x2		//Section occupies memory during execution
+
+/* Build ID note written by the linker (ld --build-id), identifies the content of a program
+ ---------------------------------------------------*/
+#define OS_ELF_BUILD_ID_SECTION		".note.gnu.build-id"
+#define OS_ELF_BUILD_ID_MAX_SIZE	64		//Largest note accepted (header, "GNU" name and a 256 bit ID fit)
+
+/* ELF ARM relocation types
+ ---------------------------------------------------*/
+#define OS_ELF_R_ARM_ABS32			2		//S + A
+#define OS_ELF_R_ARM_GLOB_DAT		21		//S
+#define OS_ELF_R_ARM_JUMP_SLOT		22		//S
+#define OS_ELF_R_ARM_RELATIVE		23		//B + A
+
+/* Maximum length of an imported symbol name
+ ---------------------------------------------------*/
+#define OS_ELF_SYM_NAME_MAX			64
+
+/* Packed image format (produced by Tools/os_pack from a PIC ELF file)
+ ---------------------------------------------------*/
+#define OS_PACK_MAGIC				0x4B50534FUL	//"OSPK"
+#define OS_PACK_VERSION				2
+
+/* Kernel ABI version, bumped when the kernel symbols given to the programs change in an incompatible way
+ ---------------------------------------------------*/
+#define OS_ABI_VERSION				1
+
+/* Launch parameters of a program (see os_manifest_t)
+ ---------------------------------------------------*/
+#define OS_MANIFEST_MAGIC			0x464D534FUL	//"OSMF"
+#define OS_MANIFEST_SECTION			".os_manifest"
+
+/* Declares the manifest of a program, in its ELF file. 0 keeps the default value of a parameter
+ ---------------------------------------------------*/
+#define OS_MANIFEST(stack, prio, heap)	__attribute__((section(OS_MANIFEST_SECTION), used)) os_manifest_t const os_manifest = \
+											{ OS_MANIFEST_MAGIC, OS_ABI_VERSION, (stack), (heap), (prio), { 0 } }
 
 /**********************************************
  * PUBLIC TYPES
@@ -76,11 +132,89 @@ typedef struct{
 	uint32_t sh_entsize;	//Contains the size, in bytes, of each entry, for sections that contain fixed-size entries. Otherwise, this field contains zero.
 } __packed os_elf_sectionHeader_t;
 
+/* ELF relocation entry (no addend, the addend is the value already stored at the location)
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t r_offset;		//Virtual address of the location to patch
+	uint32_t r_info;		//Symbol index (bits 31-8) and relocation type (bits 7-0)
+} __packed os_elf_rel_t;
+
+/* ELF symbol table entry
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t st_name;		//Offset of the name in the string table linked to the symbol table
+	uint32_t st_value;		//Virtual address of the symbol (when defined in the file)
+	uint32_t st_size;		//Size of the object
+	uint8_t  st_info;		//Type and binding
+	uint8_t  st_other;		//Visibility
+	uint16_t st_shndx;		//Index of the section defining the symbol. 0 (SHN_UNDEF) for imports
+} __packed os_elf_symbol_t;
+
+/* Program manifest : launch parameters stored in the .os_manifest section of the ELF file, or in the packed image header
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	magic;			//OS_MANIFEST_MAGIC
+	uint32_t	abiVersion;		//Kernel ABI the program was built for (OS_ABI_VERSION), 0 if any
+	uint32_t	stackSize;		//Stack size of the main thread, 0 for the default one
+	uint32_t	heapSize;		//Room left in the arena for os_heap_alloc, 0 for the default one (OS_PROCESS_HEAP_SIZE)
+	int8_t		priority;		//Priority of the main thread, 0 for the default one
+	uint8_t		pad[3];			//Padding. Unused
+} __packed os_manifest_t;
+
+/* Packed image header. It is followed by the relocation bitmap (one bit per payload word, set if the word must be moved by the
+ * load address), the payload (text then data) and the imports. Offsets are relative to the start of the image
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	magic;			//OS_PACK_MAGIC
+	uint16_t	version;		//OS_PACK_VERSION
+	uint16_t	headerSize;		//Size of this header
+	uint32_t	entry;			//Offset of the entry point
+	uint32_t	got;			//Offset of the Global Offset Table
+	uint32_t	textSize;		//Size of the read only part of the payload (multiple of 4)
+	uint32_t	dataSize;		//Size of the writable part of the payload, following the text (multiple of 4)
+	uint32_t	bssSize;		//Size of the zero filled memory following the data
+	uint32_t	importNum;		//Number of imports
+	os_manifest_t	manifest;	//Launch parameters
+} __packed os_pack_header_t;
+
+/* Packed image import. The symbol name follows, padded to 4 bytes
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	offset;			//Offset of the word receiving the kernel symbol address (added to the word)
+	uint32_t	nameLen;		//Length of the name, without terminator
+} __packed os_pack_import_t;
+
+/* Process limits (defaults in OS_Config.h)
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	heapQuota;		//Bytes the process may allocate with os_heap_alloc, block headers included (0 = up to its arena)
+	uint8_t		cpuShare;		//Share of each accounting window the process may run at its own priority, in % (100 = no limit)
+	uint8_t		maxThreads;		//Maximum number of threads
+} os_process_limits_t;
+
+/* Process resource usage
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	heapBytes;		//Bytes allocated in the arena by the process and for its arguments, block headers included
+	uint32_t	stackBytes;		//Stack reserved by the threads (filled by os_process_getUsage)
+	uint32_t	threads;		//Number of threads (filled by os_process_getUsage)
+	uint32_t	cpuTicks;		//Ticks (ms) the process was running, since it was created
+	uint32_t	cpuWindow;		//Ticks (ms) the process was running in the current accounting window
+	uint8_t		cpuLoad;		//Share of the last accounting window the process was running, in %
+	bool		throttled;		//The process used its CPU share, its threads run at OS_PROCESS_THROTTLE_PRIO until the window ends
+} os_process_usage_t;
+
 /* Process information
  ---------------------------------------------------*/
 typedef struct os_process_ {
 	int (*entry_fn)(int, char**);
 	uint8_t* segments;
+	uint32_t segSize;
+	os_heap_arena_t* arena;
+	os_process_limits_t limits;
+	os_process_usage_t usage;
+	uint8_t const* text;
+	void* textCache;
 	void* thread_list;
 	char* p_name;
 	uint32_t gotBaseAddr;
@@ -88,6 +222,18 @@ typedef struct os_process_ {
 	uint16_t PID;
 } os_process_t;
 
+/* Asynchronous process creation (see os_process_createAsync)
+ ---------------------------------------------------*/
+typedef struct os_process_job_ {
+	char* file;								//File's name
+	int argc;								//Argument number passed to the main thread
+	char** argv;							//Arguments passed to the main thread
+	os_err_e ret;							//Result of the creation
+	uint16_t PID;							//PID of the created process, 0 if error
+	void (*done)(struct os_process_job_*);	//Function called once the creation is over. NULL if none
+	void* arg;								//User argument
+} os_process_job_t;
+
 
 /**********************************************
  * PUBLIC FUNCTIONS
@@ -110,18 +256,108 @@ os_process_t* os_process_getByPID(uint16_t pid);
 /***********************************************************************
  * OS Create process
  *
- * @brief This function creates a process using its ELF file
+ * @brief This function creates a process using its ELF file or its packed image (see Tools/os_pack). The process allocates everything
+ * in its own arena of the heap, freed at once when the process is killed. The main thread stack, its priority and the room left for
+ * os_heap_alloc are taken from the manifest of the program when it has one (see OS_MANIFEST).
  *
  * @param char* file   : [in] File's name
  * @param void* argc   : [in] Argument number to be passed to the task
- * @param char* argv[] : [in] Array of strings to be passed to the task
+ * @param char* argv[] : [in] Array of heap allocated strings to be passed to the task. Freed on success (the process runs on a copy)
  *
- * @return os_err_e : An error code (0 = OK)
+ * @return os_err_e : An error code (0 = OK). OS_ERR_INVALID if the program is corrupted or was built for another kernel ABI
  *
  **********************************************************************/
 os_err_e os_process_create(char* file, int argc, char* argv[]);
 
 
+/***********************************************************************
+ * OS Create process asynchronously
+ *
+ * @brief This function queues the creation of a process on the loader task (OS_PROCESS_LOADER_PRIO), and returns immediately.
+ * On success, argv is freed (the process runs on a copy in its arena). On error, it is given back through the job passed to done.
+ *
+ * @param char* file   						: [in] File's name (copied)
+ * @param void* argc   						: [in] Argument number to be passed to the task
+ * @param char* argv[] 						: [in] Array of strings to be passed to the task
+ * @param void (*done)(os_process_job_t*) 	: [in] Function called by the loader task once the process is created or failed. NULL if none
+ * @param void* arg 						: [in] Argument stored in the job passed to done
+ * @param os_handle_t doneEvt 				: [in] Event set once the job is over (after done returned). NULL if none
+ *
+ * @return os_err_e : An error code (0 = OK) about queuing the job. The creation result is given to done
+ *
+ **********************************************************************/
+os_err_e os_process_createAsync(char* file, int argc, char* argv[], void (*done)(os_process_job_t*), void* arg, os_handle_t doneEvt);
+
+
+/***********************************************************************
+ * OS Install process
+ *
+ * @brief This function copies the text of an ELF file to the installed image area, so that the next processes created
+ * from this file execute it in place and only load their writable data into RAM. The program must have a single read only
+ * LOAD segment, no relocation may patch it, and its code must reach data through the GOT (R9) only.
+ * Installing the file again after modifying it replaces the old image.
+ *
+ * @param char* file : [in] File's name
+ *
+ * @return os_err_e : An error code (0 = OK). OS_ERR_INVALID if the program cannot execute in place or there is no room left
+ *
+ **********************************************************************/
+os_err_e os_process_install(char* file);
+
+
+/***********************************************************************
+ * OS Process heap alloc
+ *
+ * @brief This function allocates memory for the calling process, in its arena. Processes link os_heap_alloc to it.
+ * Kernel tasks get memory from the global heap
+ *
+ * @param uint32_t size : [in] Size to be allocated
+ *
+ * @return void* : Address of the memory block or NULL if the function failed (bad argument, arena full or heap quota reached)
+ **********************************************************************/
+void* os_process_heapAlloc(uint32_t size);
+
+
+/***********************************************************************
+ * OS Process heap free
+ *
+ * @brief This function frees memory allocated by os_process_heapAlloc and deducts it from the usage of the calling process.
+ * Processes link os_heap_free to it
+ *
+ * @param void* ptr : [in] Address of the memory block
+ *
+ * @return os_err_e : An error code (0 = OK)
+ **********************************************************************/
+os_err_e os_process_heapFree(void* ptr);
+
+
+/***********************************************************************
+ * OS Process set limits
+ *
+ * @brief This function changes the limits of a process. Memory already allocated and threads already running are kept,
+ * only the next requests are checked against the new limits. A new CPU share applies from the next accounting window
+ *
+ * @param os_process_t* proc 				: [in] Process reference
+ * @param os_process_limits_t const* limits : [in] New limits
+ *
+ * @return os_err_e : An error code (0 = OK)
+ **********************************************************************/
+os_err_e os_process_setLimits(os_process_t* proc, os_process_limits_t const* limits);
+
+
+/***********************************************************************
+ * OS Process get usage
+ *
+ * @brief This function takes a snapshot of the resources used by a process
+ *
+ * @param os_process_t* proc 		: [ in] Process reference
+ * @param os_process_usage_t* usage : [out] Resource usage
+ *
+ * @return os_err_e : An error code (0 = OK)
+ **********************************************************************/
+os_err_e os_process_getUsage(os_process_t* proc, os_process_usage_t* usage);
+
+
 /***********************************************************************
  * Kill a process
  *
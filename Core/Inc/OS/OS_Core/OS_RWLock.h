@@ -0,0 +1,133 @@
+/*
+ * OS_RWLock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_RWLOCK_H_
+#define INC_OS_OS_RWLOCK_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Reader-writer lock access mode
+ ---------------------------------------------------*/
+typedef enum{
+	OS_RWLOCK_MODE_READ,
+	OS_RWLOCK_MODE_WRITE,
+	__OS_RWLOCK_MODE_INVALID,
+}os_rwlock_mode_e;
+
+/* Reader-writer lock object (useful to cast from handle to lock)
+ ---------------------------------------------------*/
+typedef struct os_rwlock_{
+	os_obj_t 			obj; 		//MUST BE FIRST MEMBER. Object base structure
+	os_handle_t			writer;  	//Handle to the task holding the write access (NULL if none)
+	uint32_t			readers;	//Number of read accesses currently held
+	int8_t				max_prio;	//Store maximum priority of the waiting tasks (lent to the writer)
+} os_rwlock_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS RW Lock Create
+ *
+ * @brief This function creates a reader-writer lock. Any number of readers can hold it at the same time, a writer holds it alone.
+ * Once a writer waits, new readers are blocked (writer preference), and the writer inherits the priority of the tasks waiting for it.
+ *
+ * @param os_handle_t* h 	: [out] handle to the lock
+ * @param char* name		: [ in] lock name. If a lock with the same name already exists, its reference is returned. A null name always creates a nameless lock.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_rwlock_create(os_handle_t* h, char const * name);
+
+
+/***********************************************************************
+ * OS RW Lock Read Lock
+ *
+ * @brief This function takes the lock for reading. Waiting for the lock through os_obj_wait functions also takes it for reading.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the lock
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_TIMEOUT if the lock could not be taken in time
+ **********************************************************************/
+os_err_e os_rwlock_readLock(os_handle_t h, uint32_t timeout_ticks);
+
+
+/***********************************************************************
+ * OS RW Lock Write Lock
+ *
+ * @brief This function takes the lock for writing. The lock cannot be taken while it is held by anyone else.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the lock
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_TIMEOUT if the lock could not be taken in time
+ **********************************************************************/
+os_err_e os_rwlock_writeLock(os_handle_t h, uint32_t timeout_ticks);
+
+
+/***********************************************************************
+ * OS RW Lock Read Unlock
+ *
+ * @brief This function releases one read access
+ *
+ * @param os_handle_t h : [ in] Handle to the lock
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_FORBIDDEN if the lock is not held for reading
+ **********************************************************************/
+os_err_e os_rwlock_readUnlock(os_handle_t h);
+
+
+/***********************************************************************
+ * OS RW Lock Write Unlock
+ *
+ * @brief This function releases the write access. Must be called by the writer.
+ *
+ * @param os_handle_t h : [ in] Handle to the lock
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_FORBIDDEN if the current task is not the writer
+ **********************************************************************/
+os_err_e os_rwlock_writeUnlock(os_handle_t h);
+
+
+/***********************************************************************
+ * OS RW Lock delete
+ *
+ * @brief This function deletes a reader-writer lock. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the lock
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_rwlock_delete(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Get RW Lock from handle
+ *
+ * @brief This function gets the reader-writer lock object from the handle
+ *
+ * @param os_handle_t h : [ in] Pointer to the lock
+ *
+ * @return os_rwlock_t* : NULL if error, the lock reference if OK
+ **********************************************************************/
+static inline os_rwlock_t* os_rwlock_getFromHandle(os_handle_t h){
+	if(h == NULL) return NULL;
+	if(h->type != OS_OBJ_RWLOCK) return NULL;
+
+	return (os_rwlock_t*)h;
+}
+
+
+#endif /* INC_OS_OS_RWLOCK_H_ */
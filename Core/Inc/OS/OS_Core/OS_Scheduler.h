@@ -43,6 +43,38 @@ os_err_e os_scheduler_start();
 os_err_e os_scheduler_stop();
 
 
+/***********************************************************************
+ * OS Scheduler lock
+ *
+ * @brief Prevents context switches without disabling interrupts. Calls can be nested.
+ * The running task must not block, sleep or end while the scheduler is locked.
+ *
+ **********************************************************************/
+void os_scheduler_lock();
+
+
+/***********************************************************************
+ * OS Scheduler unlock
+ *
+ * @brief Undoes one os_scheduler_lock. The last unlock runs any context switch requested meanwhile.
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_FORBIDDEN if the scheduler was not locked
+ *
+ **********************************************************************/
+os_err_e os_scheduler_unlock();
+
+
+/***********************************************************************
+ * OS Scheduler is locked
+ *
+ * @brief Returns whether context switches are currently deferred by os_scheduler_lock
+ *
+ * @return bool : 1 = locked; 0 = unlocked
+ *
+ **********************************************************************/
+bool os_scheduler_isLocked();
+
+
 /***********************************************************************
  * OS Scheduler State get
  *
@@ -54,4 +86,14 @@ os_err_e os_scheduler_stop();
 os_scheduler_state_e os_scheduler_state_get();
 
 
+/***********************************************************************
+ * OS Scheduler Stack Fault
+ *
+ * @brief This function checks if the memory fault being handled was caused by the running task reaching its stack guard, and calls
+ * os_stack_overflow_cb if so. To be called by the MemManage and HardFault handlers (faults in critical sections are escalated)
+ *
+ **********************************************************************/
+void os_scheduler_stackFault();
+
+
 #endif /* INC_OS_OS_SCHEDULER_H_ */
@@ -0,0 +1,134 @@
+/*
+ * OS_Stream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_STREAM_H_
+#define INC_OS_OS_STREAM_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Stream buffer object (useful to cast from handle to stream)
+ ---------------------------------------------------*/
+typedef struct os_stream_{
+	os_obj_t 			obj; 		//MUST BE FIRST MEMBER. Object base structure
+	uint8_t*			buf;		//Ring buffer
+	size_t				size;		//Size of the ring buffer
+	size_t				head;		//Write index
+	size_t				tail;		//Read index
+	size_t volatile		count;		//Number of bytes in the buffer
+	size_t				trigger;	//Number of bytes needed to wake a reader
+} os_stream_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Stream Create
+ *
+ * @brief This function creates a byte stream buffer. Waiting for a stream returns once at least trigger bytes are available.
+ *
+ * @param os_handle_t* h 	: [out] handle to stream
+ * @param size_t size 		: [ in] size of the buffer in bytes
+ * @param size_t trigger 	: [ in] number of bytes that wakes a reader (1 to size)
+ * @param char* name		: [ in] stream name. If a stream with the same name already exists, its reference is returned. A null name always creates a nameless stream.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_stream_create(os_handle_t* h, size_t size, size_t trigger, char const * name);
+
+
+/***********************************************************************
+ * OS Stream Write
+ *
+ * @brief This function copies bytes into the stream. Bytes that do not fit are dropped. Never blocks nor allocates, so it can be called from interrupts.
+ *
+ * @param os_handle_t h 	: [ in] Handle to the stream
+ * @param void const* data 	: [ in] Bytes to write
+ * @param size_t len 		: [ in] Number of bytes to write
+ *
+ * @return size_t : number of bytes actually written
+ **********************************************************************/
+size_t os_stream_write(os_handle_t h, void const* data, size_t len);
+
+
+/***********************************************************************
+ * OS Stream Read
+ *
+ * @brief This function blocks until the trigger level is reached or a timeout occurs, then copies up to len bytes.
+ * On timeout, the bytes already available (if any) are returned.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the stream
+ * @param void* data 				: [out] Buffer to receive the bytes
+ * @param size_t len 				: [ in] Maximum number of bytes to read
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ * @param os_err_e* err 			: [out] Error code. OS_ERR_TIMEOUT if nothing was read. NULL to ignore
+ *
+ * @return size_t : number of bytes read
+ **********************************************************************/
+size_t os_stream_read(os_handle_t h, void* data, size_t len, uint32_t timeout_ticks, os_err_e* err);
+
+
+/***********************************************************************
+ * OS Stream Reset
+ *
+ * @brief This function discards every byte in the stream
+ *
+ * @param os_handle_t h : [ in] Handle to the stream
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_stream_reset(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Stream Get Count
+ *
+ * @brief This function gets the number of bytes waiting in the stream
+ *
+ * @param os_handle_t h : [ in] Handle to the stream
+ *
+ * @return size_t : number of bytes, 0 if error
+ **********************************************************************/
+size_t os_stream_getCount(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Stream delete
+ *
+ * @brief This function deletes a stream. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the stream
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_stream_delete(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Get Stream from handle
+ *
+ * @brief This function gets the stream object from the handle
+ *
+ * @param os_handle_t h : [ in] Pointer to the stream
+ *
+ * @return os_stream_t* : NULL if error, the stream reference if OK
+ **********************************************************************/
+static inline os_stream_t* os_stream_getFromHandle(os_handle_t h){
+	if(h == NULL) return NULL;
+	if(h->type != OS_OBJ_STREAM) return NULL;
+
+	return (os_stream_t*)h;
+}
+
+
+#endif /* INC_OS_OS_STREAM_H_ */
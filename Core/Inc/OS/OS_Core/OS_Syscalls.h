@@ -20,6 +20,8 @@ typedef enum os_syscall_ {
 	OS_SYSCALL_FCLOSE		= 1,
 	OS_SYSCALL_FREAD		= 2,
 	OS_SYSCALL_FWRITE		= 3,
+	OS_SYSCALL_GETTICK		= 4,
+	__OS_SYSCALL_MAX,
 } os_syscall_e;
 
 
@@ -31,11 +33,13 @@ typedef enum os_syscall_ {
 /***********************************************************************
  * Os syscall
  *
- * @brief This function prepares a stack frame for all arguments, and calls the syscall interrupt
+ * @brief This function prepares a stack frame for all arguments, and calls the syscall interrupt.
+ * Non blocking calls are executed inside the interrupt, blocking calls are executed by the caller task once the interrupt returns.
  *
  * @param os_syscall_e call : [in] Syscall ID
  * @param ...               : [in] arguments to send to syscall
  *
+ * @return void* : value returned by the syscall, OS_ERR_INVALID if the ID is unknown
  **********************************************************************/
 void* os_syscall(os_syscall_e call, void* arg1, void* arg2, void* arg3, void* arg4, void* arg5, void* arg6, void* arg7, void* arg8);
 
@@ -12,6 +12,7 @@
 #include "OS/OS_Core/OS_Obj.h"
 #include "OS/OS_Core/OS_Tick.h"
 #include "OS/OS_Core/OS_Process.h"
+#include "OS/OS_Core/OS_RWLock.h"
 
 /**********************************************
  * PUBLIC TYPES
@@ -56,6 +57,7 @@ typedef struct os_task_{
 	void*				ownedMutex;			//List containing all mutexes owned by this task
 	void*				retVal;				//Return value;
 	int8_t				priority;			//Used internally to store calculated priority
+	os_rwlock_mode_e	rwMode;				//Access wanted when waiting for a reader-writer lock
 
 	int					argc;				//Used to store the number of arguments when loading an elf.
 	char**				argv;				//Array of strings for each argument
@@ -89,7 +91,8 @@ os_err_e os_task_create(os_handle_t* h, char const * name, void* (*fn)(void*), o
 /***********************************************************************
  * OS Task Create Process flavor
  *
- * @brief This function creates a new task, that will be called by the scheduler when the correct time comes
+ * @brief This function creates a new task, that will be called by the scheduler when the correct time comes.
+ * The kernel data page (os_kdata_t const*) is passed as the third argument of fn.
  *
  * @param os_handle_t* h						: [out] handle to object
  * @param char* name 							: [ in] name of the task
@@ -102,7 +105,7 @@ os_err_e os_task_create(os_handle_t* h, char const * name, void* (*fn)(void*), o
  * @param char** argv  						    : [ in] argv argument to be passed to the task
  * @param uint32_t r9  						    : [ in] r9 value (must be GOT base address)
  *
- * @return os_err_e : An error code (0 = OK)
+ * @return os_err_e : An error code (0 = OK). OS_ERR_FORBIDDEN if the process reached its thread limit
  *
  **********************************************************************/
 os_err_e os_task_createProc(os_handle_t* h, char const * name, int (*fn)(int argc, char* argv[]), os_process_t* proc, os_task_mode_e mode, int8_t priority, uint32_t stack_size, int argc, char** argv, uint32_t r9);
@@ -139,7 +142,8 @@ os_err_e os_task_return(void* retVal);
 /***********************************************************************
  * OS Task delete
  *
- * @brief This function deletes a task, removing it from task list and freeing its block
+ * @brief This function deletes a task, removing it from task list and freeing its block.
+ * A task deleting itself only becomes a zombie: its memory is freed later by os_task_reap, outside the context switch.
  *
  * ATTENTION : if the current tasks kills itself, the IRQ will be enabled regardless of its previous state
  *
@@ -151,6 +155,18 @@ os_err_e os_task_return(void* retVal);
 os_err_e os_task_delete(os_handle_t h);
 
 
+/***********************************************************************
+ * OS Task Reap
+ *
+ * @brief This function frees every task that deleted itself (zombie). It is called by the default idle task;
+ * a custom os_idle_task_fn (or any low priority task) should call it too. Task creations free up to OS_TASK_REAP_ON_CREATE zombies as well.
+ *
+ * @return uint32_t : number of tasks freed
+ *
+ **********************************************************************/
+uint32_t os_task_reap();
+
+
 /***********************************************************************
  * OS Task Yeild
  *
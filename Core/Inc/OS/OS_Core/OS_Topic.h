@@ -7,9 +7,18 @@
  * PUBLIC TYPES
  *********************************************/
 
+/* Topic mode
+ ---------------------------------------------------*/
+typedef enum{
+    OS_TOPIC_MODE_QUEUED,           //Every message is queued for every subscriber
+    OS_TOPIC_MODE_CONFLATED,        //Subscribers only keep the latest message (one slot mailbox each)
+    __OS_TOPIC_MODE_INVALID
+} os_topic_mode_e;
+
 typedef struct os_topic_{
 	os_obj_t  obj;				//Base object (must be first member)
     void*     msgQlist;
+    os_topic_mode_e mode;       //Topic mode
 } os_topic_t;
 
 /**********************************************
@@ -17,16 +26,17 @@ typedef struct os_topic_{
  *********************************************/
 
 /***********************************************************************
- * OS Topic create
+ * OS Topic create mode
  *
- * @brief Creates a new topic
+ * @brief Creates a new topic with the given mode
  *
- * @param os_handle_t* h : [out] Topic handle
- * @param char* name     : [ in] Topic name or NULL to create an nameless topic
+ * @param os_handle_t* h        : [out] Topic handle
+ * @param os_topic_mode_e mode  : [ in] Topic mode. Conflated topics only keep the latest message for each subscriber
+ * @param char* name            : [ in] Topic name or NULL to create an nameless topic
  *
  * @return os_err_e error code (0 = OK)
  **********************************************************************/
-os_err_e os_topic_create(os_handle_t* h, char const * name);
+os_err_e os_topic_createMode(os_handle_t* h, os_topic_mode_e mode, char const * name);
 
 
 /***********************************************************************
@@ -67,6 +77,21 @@ os_err_e os_topic_unsubscribeTask(os_handle_t topic, os_handle_t task);
 void* os_topic_receive(os_handle_t topic, os_err_e* err);
 
 
+/***********************************************************************
+ * OS Topic Receive Latest
+ *
+ * @brief Receive the latest message published in a conflated topic, along with its sequence number.
+ * Gaps in the sequence tell how many messages were overwritten since the last read.
+ *
+ * @param os_handle_t topic : [ in] Handle to topic
+ * @param uint32_t* seq     : [out] Sequence number of the message (or null to ignore)
+ * @param os_err_e* err     : [out] Error code (or null to ignore)
+ * 
+ * @return void* : message or NULL if nothing
+ **********************************************************************/
+void* os_topic_receiveLatest(os_handle_t topic, uint32_t* seq, os_err_e* err);
+
+
 /***********************************************************************
  * OS Topic Publish
  *
@@ -95,6 +120,21 @@ os_err_e os_topic_delete(os_handle_t topic);
  * PUBLIC INLINE FUNCTIONS
  *********************************************/
 
+/***********************************************************************
+ * OS Topic create
+ *
+ * @brief Creates a new queued topic
+ *
+ * @param os_handle_t* h : [out] Topic handle
+ * @param char* name     : [ in] Topic name or NULL to create an nameless topic
+ *
+ * @return os_err_e error code (0 = OK)
+ **********************************************************************/
+static inline os_err_e os_topic_create(os_handle_t* h, char const * name){
+    return os_topic_createMode(h, OS_TOPIC_MODE_QUEUED, name);
+}
+
+
 /***********************************************************************
  * OS Topic 
  *
@@ -0,0 +1,117 @@
+/*
+ * OS_WaitSet.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_WAITSET_H_
+#define INC_OS_OS_WAITSET_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Wait-set object (useful to cast from handle to wait-set)
+ ---------------------------------------------------*/
+typedef struct os_waitset_{
+	os_obj_t 		obj; 			//MUST BE FIRST MEMBER. Object base structure
+	void*			memberList;		//List containing all objects registered in the wait-set
+} os_waitset_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Wait-set Create
+ *
+ * @brief This function creates a wait-set. Objects are registered once, then the wait-set can be waited
+ * any number of times without registering the task in each object's block list.
+ *
+ * @param os_handle_t* h 	: [out] handle to wait-set
+ * @param char* name		: [ in] wait-set name. If a wait-set with the same name already exists, its reference is returned. A null name always creates a nameless wait-set.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_waitset_create(os_handle_t* h, char const * name);
+
+
+/***********************************************************************
+ * OS Wait-set Add
+ *
+ * @brief This function registers an object in the wait-set. An object can only belong to one wait-set at a time.
+ *
+ * @param os_handle_t h 	: [ in] Handle to the wait-set
+ * @param os_handle_t obj 	: [ in] Object to register (any object but a wait-set)
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_INVALID if the object already belongs to another wait-set
+ **********************************************************************/
+os_err_e os_waitset_add(os_handle_t h, os_handle_t obj);
+
+
+/***********************************************************************
+ * OS Wait-set Remove
+ *
+ * @brief This function unregisters an object from the wait-set. Deleting the object unregisters it as well.
+ *
+ * @param os_handle_t h 	: [ in] Handle to the wait-set
+ * @param os_handle_t obj 	: [ in] Object to unregister
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_waitset_remove(os_handle_t h, os_handle_t obj);
+
+
+/***********************************************************************
+ * OS Wait-set Wait
+ *
+ * @brief This function blocks until at least one registered object is available, then lists every available object.
+ * Objects are not taken: the caller takes them afterwards (e.g. os_obj_single_wait with OS_WAIT_NONE, os_msgQ_pop...).
+ * A task blocked on a wait-set does not lend its priority to the owners of registered mutexes.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the wait-set
+ * @param os_handle_t ready[] 		: [out] Array receiving the available objects
+ * @param size_t maxReady 			: [ in] Size of the ready array
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ * @param os_err_e* err 			: [out] Error code. NULL to ignore
+ *
+ * @return size_t : number of objects written in the ready array
+ **********************************************************************/
+size_t os_waitset_wait(os_handle_t h, os_handle_t ready[], size_t maxReady, uint32_t timeout_ticks, os_err_e* err);
+
+
+/***********************************************************************
+ * OS Wait-set delete
+ *
+ * @brief This function unregisters every object and deletes the wait-set. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the wait-set
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_waitset_delete(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Get Wait-set from handle
+ *
+ * @brief This function gets the wait-set object from the handle
+ *
+ * @param os_handle_t h : [ in] Pointer to the wait-set
+ *
+ * @return os_waitset_t* : NULL if error, the wait-set reference if OK
+ **********************************************************************/
+static inline os_waitset_t* os_waitset_getFromHandle(os_handle_t h){
+	if(h == NULL) return NULL;
+	if(h->type != OS_OBJ_WAITSET) return NULL;
+
+	return (os_waitset_t*)h;
+}
+
+
+#endif /* INC_OS_OS_WAITSET_H_ */
@@ -0,0 +1,123 @@
+/*
+ * OS_WorkQ.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_WORKQ_H_
+#define INC_OS_OS_WORKQ_H_
+
+#include "OS/OS_Core/OS_Common.h"
+#include "OS/OS_Core/OS_Obj.h"
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Work item (allocated by the submit functions, freed once done)
+ ---------------------------------------------------*/
+typedef struct os_work_{
+	void			(*fn)(void*);	//Function to execute
+	void*			arg;			//Argument passed to fn
+	os_handle_t		doneEvt;		//Event set once fn returned (NULL if none)
+	uint32_t		due;			//ms tick at which a delayed work must be queued
+} os_work_t;
+
+/* Work queue object (useful to cast from handle to work queue)
+ ---------------------------------------------------*/
+typedef struct os_workq_{
+	os_obj_t 		obj; 			//MUST BE FIRST MEMBER. Object base structure
+	os_handle_t		queue;			//Message queue holding the works ready to run
+	os_handle_t		kick;			//Auto reset event used to make a worker recompute its timeout
+	void*			delayedList;	//List containing the delayed works not due yet
+	os_handle_t*	workers;		//Array of worker tasks
+	size_t			nWorkers;		//Number of worker tasks
+	uint32_t		busy;			//Number of works submitted and not done yet
+	bool			stop;			//Set by os_workq_delete to make the workers return once idle
+} os_workq_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Work Queue Create
+ *
+ * @brief This function creates a work queue and its worker tasks. Works are executed in submission order by the first free worker.
+ * Waiting for a work queue returns once every work submitted is done.
+ *
+ * @param os_handle_t* h 		: [out] handle to work queue
+ * @param size_t nWorkers 		: [ in] Number of worker tasks (at least 1)
+ * @param int8_t priority 		: [ in] Priority of the worker tasks
+ * @param uint32_t stack_size 	: [ in] Stack size of each worker task
+ * @param char* name			: [ in] work queue name. If a work queue with the same name already exists, its reference is returned. A null name always creates a nameless work queue.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_create(os_handle_t* h, size_t nWorkers, int8_t priority, uint32_t stack_size, char const * name);
+
+
+/***********************************************************************
+ * OS Work Queue Submit
+ *
+ * @brief This function queues a function to be executed by a worker task
+ *
+ * @param os_handle_t h 		: [ in] Handle to the work queue
+ * @param void (*fn)(void*) 	: [ in] Function to execute
+ * @param void* arg 			: [ in] Argument passed to fn
+ * @param os_handle_t doneEvt 	: [ in] Event set once fn returned. NULL if none
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_submit(os_handle_t h, void (*fn)(void*), void* arg, os_handle_t doneEvt);
+
+
+/***********************************************************************
+ * OS Work Queue Submit Delayed
+ *
+ * @brief This function queues a function to be executed by a worker task once a delay has elapsed
+ *
+ * @param os_handle_t h 		: [ in] Handle to the work queue
+ * @param void (*fn)(void*) 	: [ in] Function to execute
+ * @param void* arg 			: [ in] Argument passed to fn
+ * @param os_handle_t doneEvt 	: [ in] Event set once fn returned. NULL if none
+ * @param uint32_t delay_ms 	: [ in] Minimum amount of ms before the work is executed
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_submitDelayed(os_handle_t h, void (*fn)(void*), void* arg, os_handle_t doneEvt, uint32_t delay_ms);
+
+
+/***********************************************************************
+ * OS Work Queue delete
+ *
+ * @brief This function deletes a work queue and its workers. Works being executed are allowed to finish first,
+ * works not started yet are dropped. It must not be called by a worker nor if there is a task waiting for the work queue.
+ *
+ * @param os_handle_t h : [ in] Handle to the work queue
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_delete(os_handle_t h);
+
+
+/***********************************************************************
+ * OS Get Work Queue from handle
+ *
+ * @brief This function gets the work queue object from the handle
+ *
+ * @param os_handle_t h : [ in] Pointer to the work queue
+ *
+ * @return os_workq_t* : NULL if error, the work queue reference if OK
+ **********************************************************************/
+static inline os_workq_t* os_workq_getFromHandle(os_handle_t h){
+	if(h == NULL) return NULL;
+	if(h->type != OS_OBJ_WORKQ) return NULL;
+
+	return (os_workq_t*)h;
+}
+
+
+#endif /* INC_OS_OS_WORKQ_H_ */
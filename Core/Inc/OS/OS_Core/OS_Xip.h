@@ -0,0 +1,135 @@
+/*
+ * OS_Xip.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#ifndef INC_OS_OS_XIP_H_
+#define INC_OS_OS_XIP_H_
+
+#include "OS/OS_Core/OS_Common.h"
+
+/**********************************************
+ * DEFINES
+ *********************************************/
+
+#define OS_XIP_BASE_ADDR			((uint32_t)__xip_start)		//First address of the installed image area
+#define OS_XIP_END_ADDR				((uint32_t)__xip_end)		//End of the installed image area
+#define OS_XIP_SECTOR_SIZE			(128*1024)					//Erase granularity of the area
+
+#define OS_XIP_MAGIC				0x31504958UL				//"XIP1", marks a valid image
+#define OS_XIP_ALIGN				256							//Alignment of every image header and text
+#define OS_XIP_NAME_LEN				32							//Maximum length of the file name stored with an image (including '\0')
+#define OS_XIP_HASH_INIT			2166136261UL				//Initial value of os_xip_hash
+
+/**********************************************
+ * EXTERNAL VARIABLES
+ *********************************************/
+
+extern char __xip_start[];
+extern char __xip_end[];
+
+/**********************************************
+ * PUBLIC TYPES
+ *********************************************/
+
+/* Installed image header, stored in flash right before the text. Images are appended one after the other.
+ * An erased size ends the list, a null magic marks an image replaced by a newer install.
+ ---------------------------------------------------*/
+typedef struct os_xip_image_{
+	uint32_t	magic;						//OS_XIP_MAGIC once the image is complete, 0 once replaced
+	uint32_t	size;						//Size of the text following the header
+	uint32_t	key;						//Identifies the ELF build and the text content the image comes from
+	char		name[OS_XIP_NAME_LEN];		//Name of the ELF file
+} os_xip_image_t;
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS XIP hash
+ *
+ * @brief This function adds a block of data to a hash (FNV-1a). Start with OS_XIP_HASH_INIT
+ *
+ * @param uint32_t h 			: [in] Current hash
+ * @param void const* data 		: [in] Block to add
+ * @param size_t size 			: [in] Size of the block
+ *
+ * @return uint32_t : the new hash
+ **********************************************************************/
+uint32_t os_xip_hash(uint32_t h, void const* data, size_t size);
+
+
+/***********************************************************************
+ * OS XIP key
+ *
+ * @brief This function computes the key identifying an ELF build, from its header and program header table
+ *
+ * @param void const* header 	: [in] ELF header
+ * @param size_t headerSize 	: [in] Size of the ELF header
+ * @param void const* ph 		: [in] Program header table
+ * @param size_t phSize 		: [in] Size of the program header table
+ *
+ * @return uint32_t : the key
+ **********************************************************************/
+uint32_t os_xip_key(void const* header, size_t headerSize, void const* ph, size_t phSize);
+
+
+/***********************************************************************
+ * OS XIP find
+ *
+ * @brief This function searches the installed text of an ELF file
+ *
+ * @param char const* name 	: [in] Name of the ELF file
+ * @param uint32_t key 		: [in] Key of the ELF build
+ * @param uint32_t size 	: [in] Size of the text
+ *
+ * @return uint8_t const* : address of the text in flash, NULL if the file is not installed or was modified since
+ **********************************************************************/
+uint8_t const* os_xip_find(char const* name, uint32_t key, uint32_t size);
+
+
+/***********************************************************************
+ * OS XIP reserve
+ *
+ * @brief This function reserves room for a new image at the end of the area and writes its header. The image stays invalid until os_xip_commit.
+ * Must be called with the FS mutex held
+ *
+ * @param char const* name 	: [ in] Name of the ELF file
+ * @param uint32_t key 		: [ in] Key of the ELF build
+ * @param uint32_t size 	: [ in] Size of the text
+ * @param uint32_t* addr 	: [out] Flash address where the text must be written
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_INVALID if there is no room left (os_xip_clear must be called)
+ **********************************************************************/
+os_err_e os_xip_reserve(char const* name, uint32_t key, uint32_t size, uint32_t* addr);
+
+
+/***********************************************************************
+ * OS XIP commit
+ *
+ * @brief This function validates an image whose text was written, and invalidates older images of the same file.
+ * Must be called with the FS mutex held
+ *
+ * @param uint32_t addr : [in] Text address returned by os_xip_reserve
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_xip_commit(uint32_t addr);
+
+
+/***********************************************************************
+ * OS XIP clear
+ *
+ * @brief This function erases every installed image. It fails while a process runs from the area.
+ * The FS mutex is held meanwhile: lfs shares the flash driver, and loads hold it until their process is registered
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_FORBIDDEN if a process uses the area
+ **********************************************************************/
+os_err_e os_xip_clear();
+
+
+#endif /* INC_OS_OS_XIP_H_ */
@@ -42,6 +42,65 @@
 #define OS_SET_PENDSV()						do { OS_SET_BITS(OS_SYSTEM_CTRL->ICSR, OS_SYSTEM_CTRL_ICSR_PENDSVSET); } while(0)
 #define OS_PENDSV_SET_PRIO(x)				do { OS_SYSTEM_CTRL->SHP[10] = (uint8_t)(( (x) << 4 ) & (uint32_t)0xFFUL); }while(0);
 
+#define OS_SYSTEM_CTRL_SHCSR_MEMFAULTENA_Pos	(16U)
+#define OS_SYSTEM_CTRL_SHCSR_MEMFAULTENA_Msk	(0x1UL << OS_SYSTEM_CTRL_SHCSR_MEMFAULTENA_Pos)
+#define OS_SYSTEM_CTRL_SHCSR_MEMFAULTENA		(OS_SYSTEM_CTRL_SHCSR_MEMFAULTENA_Msk)
+
+#define OS_SYSTEM_CTRL_CFSR_MSTKERR_Pos		(4U)
+#define OS_SYSTEM_CTRL_CFSR_MSTKERR_Msk		(0x1UL << OS_SYSTEM_CTRL_CFSR_MSTKERR_Pos)
+#define OS_SYSTEM_CTRL_CFSR_MSTKERR			(OS_SYSTEM_CTRL_CFSR_MSTKERR_Msk)
+
+#define OS_SYSTEM_CTRL_CFSR_MMARVALID_Pos	(7U)
+#define OS_SYSTEM_CTRL_CFSR_MMARVALID_Msk	(0x1UL << OS_SYSTEM_CTRL_CFSR_MMARVALID_Pos)
+#define OS_SYSTEM_CTRL_CFSR_MMARVALID		(OS_SYSTEM_CTRL_CFSR_MMARVALID_Msk)
+
+#define OS_MEMFAULT_ENABLE()				OS_SET_BITS(OS_SYSTEM_CTRL->SHCSR, OS_SYSTEM_CTRL_SHCSR_MEMFAULTENA)
+
+#define OS_EXC_FRAME_MAX_SIZE				(0x68)	//Exception frame with the FPU context
+
+
+/* MPU defines
+ ---------------------------------------------------*/
+#define OS_MPU_BASE							(0xE000ED90)
+#define OS_MPU								((MPU_TypeDef*) OS_MPU_BASE)
+
+#define OS_MPU_CTRL_ENABLE_Pos				(0U)
+#define OS_MPU_CTRL_ENABLE_Msk				(0x1UL << OS_MPU_CTRL_ENABLE_Pos)
+#define OS_MPU_CTRL_ENABLE					(OS_MPU_CTRL_ENABLE_Msk)
+
+#define OS_MPU_CTRL_PRIVDEFENA_Pos			(2U)
+#define OS_MPU_CTRL_PRIVDEFENA_Msk			(0x1UL << OS_MPU_CTRL_PRIVDEFENA_Pos)
+#define OS_MPU_CTRL_PRIVDEFENA				(OS_MPU_CTRL_PRIVDEFENA_Msk)
+
+#define OS_MPU_RASR_ENABLE_Pos				(0U)
+#define OS_MPU_RASR_ENABLE_Msk				(0x1UL << OS_MPU_RASR_ENABLE_Pos)
+#define OS_MPU_RASR_ENABLE					(OS_MPU_RASR_ENABLE_Msk)
+
+#define OS_MPU_RASR_SIZE_Pos				(1U)
+#define OS_MPU_RASR_SIZE_Msk				(0x1FUL << OS_MPU_RASR_SIZE_Pos)
+#define OS_MPU_RASR_SIZE(bytes)				((uint32_t)((31 - __builtin_clz(bytes)) - 1) << OS_MPU_RASR_SIZE_Pos)	//Region of 2^(SIZE + 1) bytes
+
+#define OS_MPU_RASR_C_Pos					(17U)
+#define OS_MPU_RASR_C_Msk					(0x1UL << OS_MPU_RASR_C_Pos)
+#define OS_MPU_RASR_C						(OS_MPU_RASR_C_Msk)
+
+#define OS_MPU_RASR_S_Pos					(18U)
+#define OS_MPU_RASR_S_Msk					(0x1UL << OS_MPU_RASR_S_Pos)
+#define OS_MPU_RASR_S						(OS_MPU_RASR_S_Msk)
+
+#define OS_MPU_RASR_XN_Pos					(28U)
+#define OS_MPU_RASR_XN_Msk					(0x1UL << OS_MPU_RASR_XN_Pos)
+#define OS_MPU_RASR_XN						(OS_MPU_RASR_XN_Msk)
+
+#define OS_MPU_STACK_GUARD_REGION			7		//Highest region number, so the guard wins over any other region
+#define OS_MPU_STACK_GUARD_RASR				(OS_MPU_RASR_XN | OS_MPU_RASR_S | OS_MPU_RASR_C | OS_MPU_RASR_SIZE(OS_STACK_GUARD_SIZE) | OS_MPU_RASR_ENABLE) //AP = 0 : no access
+
+#if OS_STACK_GUARD_EN == 1 && (OS_STACK_GUARD_SIZE < 32 || (OS_STACK_GUARD_SIZE & (OS_STACK_GUARD_SIZE - 1)) != 0)
+#error "OS_STACK_GUARD_SIZE must be a power of 2, 32 at least"
+#endif
+
+#define OS_MPU_ENABLE()						do { OS_MPU->CTRL = OS_MPU_CTRL_PRIVDEFENA | OS_MPU_CTRL_ENABLE; __asm volatile("dsb\n isb" ::: "memory"); } while(0)
+
 
 /* FPU defines
  ---------------------------------------------------*/
@@ -102,6 +161,14 @@ typedef struct{
 	__OS_OM  uint32_t STIR; 			//Software Triggered Interrupt Register
 }SystemControl_TypeDef;
 
+typedef struct{
+	__OS_IM  uint32_t TYPE;			//MPU Type Register
+	__OS_IOM uint32_t CTRL;			//MPU Control Register
+	__OS_IOM uint32_t RNR;			//MPU Region Number Register
+	__OS_IOM uint32_t RBAR;			//MPU Region Base Address Register
+	__OS_IOM uint32_t RASR;			//MPU Region Attribute and Size Register
+}MPU_TypeDef;
+
 typedef struct{
 	__OS_IOM uint32_t FPCCR;		//FP Context Control Register
 	__OS_IOM uint32_t FPCAR;		//FP Context Address Register
@@ -11,6 +11,9 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "OS/OS_Core/OS_Obj.h"
+#include "OS/OS_Core/OS_Syscalls.h"
+
 /**********************************************
  * PUBLIC TYPES
  *********************************************/
@@ -28,6 +31,36 @@ typedef enum{
 	__OS_FS_SEEK_MAX,
 }os_fs_seek_e;
 
+/* I/O ring submission entry, filled by the process
+ ---------------------------------------------------*/
+typedef struct os_fs_sqe_{
+	os_syscall_e		op;			//OS_SYSCALL_FOPEN, OS_SYSCALL_FCLOSE, OS_SYSCALL_FREAD or OS_SYSCALL_FWRITE
+	uint32_t			arg[4];		//Arguments, in the same order as the matching os_f* function
+	uint32_t			user_data;	//Copied as is to the completion entry
+} os_fs_sqe_t;
+
+/* I/O ring completion entry, filled by the kernel
+ ---------------------------------------------------*/
+typedef struct os_fs_cqe_{
+	uint32_t			user_data;	//Copied from the submission entry
+	int32_t				res;		//Value returned by the operation
+} os_fs_cqe_t;
+
+/* I/O ring. Indexes are free running, the entry used is index & (size - 1)
+ ---------------------------------------------------*/
+typedef struct os_fs_ring_{
+	uint32_t			size;		//Number of entries in each ring (power of 2)
+	uint32_t			sq_prep;	//Next submission entry handed to the process, not visible to the kernel yet
+	uint32_t volatile	sq_head;	//Next submission entry the kernel executes
+	uint32_t volatile	sq_tail;	//End of the submitted entries
+	uint32_t volatile	cq_head;	//Next completion entry the process consumes
+	uint32_t volatile	cq_tail;	//End of the posted completion entries
+	bool volatile		armed;		//A batch is queued or being executed by the kernel worker
+	os_fs_sqe_t*		sq;			//Submission entries
+	os_fs_cqe_t*		cq;			//Completion entries
+	os_handle_t			cqEvt;		//Auto reset event set after each batch
+} os_fs_ring_t;
+
 /**********************************************
  * PUBLIC FUNCTIONS
  *********************************************/
@@ -110,4 +143,89 @@ size_t os_fwrite(const void * ptr, size_t size, size_t count, OS_FILE * stream )
 int os_fseek(OS_FILE* fstream, int32_t offset, os_fs_seek_e whence);
 
 
+/***********************************************************************
+ * OS File Ring Create
+ *
+ * @brief This function creates a pair of submission and completion rings, shared between the caller and the kernel.
+ * Operations queued in the submission ring are executed in batches by a kernel worker, under a single FS lock.
+ *
+ * @param os_fs_ring_t** ring 	: [out] Reference to the ring
+ * @param uint32_t size 		: [ in] Number of entries of each ring. Must be a power of 2
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_fs_ring_create(os_fs_ring_t** ring, uint32_t size);
+
+
+/***********************************************************************
+ * OS File Ring Get Submission Entry
+ *
+ * @brief This function returns the next free submission entry. The entry is only seen by the kernel after os_fs_ring_submit.
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_fs_sqe_t* : the entry to fill, NULL if every entry is in use (submitted or waiting to be consumed as a completion)
+ **********************************************************************/
+os_fs_sqe_t* os_fs_ring_getSqe(os_fs_ring_t* ring);
+
+
+/***********************************************************************
+ * OS File Ring Submit
+ *
+ * @brief This function hands every entry obtained with os_fs_ring_getSqe to the kernel, and notifies the worker once
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_fs_ring_submit(os_fs_ring_t* ring);
+
+
+/***********************************************************************
+ * OS File Ring Peek Completion
+ *
+ * @brief This function returns the oldest completion entry not consumed, without waiting
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_fs_cqe_t* : the completion entry, NULL if there is none
+ **********************************************************************/
+os_fs_cqe_t* os_fs_ring_peekCqe(os_fs_ring_t* ring);
+
+
+/***********************************************************************
+ * OS File Ring Wait Completion
+ *
+ * @brief This function returns the oldest completion entry not consumed, waiting for one if needed
+ *
+ * @param os_fs_ring_t* ring 		: [in] Reference to the ring
+ * @param uint32_t timeout_ms 	: [in] Amount of ms to wait. OS_WAIT_FOREVER is accepted
+ *
+ * @return os_fs_cqe_t* : the completion entry, NULL if none was posted in time
+ **********************************************************************/
+os_fs_cqe_t* os_fs_ring_waitCqe(os_fs_ring_t* ring, uint32_t timeout_ms);
+
+
+/***********************************************************************
+ * OS File Ring Completion Seen
+ *
+ * @brief This function consumes the completion entry returned by os_fs_ring_peekCqe or os_fs_ring_waitCqe, freeing its slot
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ **********************************************************************/
+void os_fs_ring_cqeSeen(os_fs_ring_t* ring);
+
+
+/***********************************************************************
+ * OS File Ring Delete
+ *
+ * @brief This function deletes a ring. It fails while the kernel still executes a batch of it.
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_FORBIDDEN if a batch is in progress
+ **********************************************************************/
+os_err_e os_fs_ring_delete(os_fs_ring_t* ring);
+
+
 #endif /* INC_OS_OS_FS_OS_FS_H_ */
@@ -12,6 +12,8 @@
 #include "stdio.h"
 #include "stdint.h"
 
+#include "OS/OS_Core/OS_Common.h"
+
 /**********************************************
  * DEFINES
  *********************************************/
@@ -33,6 +35,16 @@ typedef struct{
  * PUBLIC FUNCTIONS
  *********************************************/
 
+/***********************************************************************
+ * OS shared library init
+ *
+ * @brief This function builds the hash index used by os_sl_translate. Must be called once before loading any process
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_INVALID if the link table is too big or has a duplicated name
+ **********************************************************************/
+os_err_e os_sl_init();
+
+
 /***********************************************************************
  * OS shared library translate
  *
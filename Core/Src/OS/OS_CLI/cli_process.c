@@ -16,7 +16,7 @@
 
 static char cli_char;
 static char cliBuffer[128];
-static os_handle_t cli_evt;
+static os_handle_t cli_stream;
 
 /**********************************************
  * CALLBACK FUNCTIONS
@@ -25,16 +25,13 @@ static os_handle_t cli_evt;
 /***********************************************************************
  * CLI Receive char (IRQ)
  *
- * @brief This function receives a character and puts in the cli buffer
+ * @brief This function receives a character and hands it to the cli task through the stream
  *
  **********************************************************************/
 void cli_rcv_char_cb_irq(){
-	cli_insert_char(cliBuffer, sizeof(cliBuffer), cli_char);
+	os_stream_write(cli_stream, &cli_char, 1);
 	HAL_UART_Transmit(&USART_CLI, (uint8_t*)&cli_char, 1, 10);
 
-	if(cli_char == '\n')
-		os_evt_set(cli_evt);
-
 	HAL_UART_Receive_IT(&USART_CLI, (uint8_t*)&cli_char, 1);
 }
 
@@ -50,6 +47,7 @@ void cli_rcv_char_cb_irq(){
  **********************************************************************/
 void cli_init(void){
 	memset(cliBuffer, 0, sizeof(cliBuffer));
+	os_stream_reset(cli_stream);
 	HAL_UART_Abort(&USART_CLI);
 	HAL_UART_AbortReceive_IT(&USART_CLI);
 	__HAL_UART_FLUSH_DRREGISTER(&USART_CLI);
@@ -63,12 +61,17 @@ void cli_init(void){
  *
  **********************************************************************/
 void cli_process(void){
-	ASSERT(os_evt_create(&cli_evt, OS_EVT_MODE_AUTO, "cli_evt") == OS_ERR_OK);
+	ASSERT(os_stream_create(&cli_stream, sizeof(cliBuffer), 1, "cli_stream") == OS_ERR_OK);
 
 	cli_init();
 
 	while(1){
-		cli_treat_command(cliBuffer, sizeof(cliBuffer));
-		os_obj_single_wait(cli_evt, OS_WAIT_FOREVER, NULL);
+		char rcv[16];
+		size_t len = os_stream_read(cli_stream, rcv, sizeof(rcv), OS_WAIT_FOREVER, NULL);
+
+		for(size_t i = 0; i < len; i++){
+			cli_insert_char(cliBuffer, sizeof(cliBuffer), rcv[i]);
+			cli_treat_command(cliBuffer, sizeof(cliBuffer));
+		}
 	}
 }
@@ -19,12 +19,70 @@ static void reset(){
 	NVIC_SystemReset();
 }
 
+static uint32_t bench_run(os_handle_t h, bool fast, uint32_t loops){
+
+	/* Take and release the object, through os_obj_single_wait (fast path) or a one object os_obj_multiple_WaitOne (generic wait)
+	 ------------------------------------------------------*/
+	uint32_t start = DWT->CYCCNT;
+	for(uint32_t i = 0; i < loops; i++){
+		if(fast)
+			os_obj_single_wait(h, OS_WAIT_NONE, NULL);
+		else
+			os_obj_multiple_WaitOne(NULL, OS_WAIT_NONE, 1, h);
+
+		if(h->type == OS_OBJ_MUTEX)
+			os_mutex_release(h);
+		else
+			os_sem_release(h, 1);
+	}
+
+	return (DWT->CYCCNT - start) / loops;
+}
+
+static void bench(){
+
+	/* Get argument
+	 ------------------------------------------------------*/
+	uint32_t loops = cli_get_uint32_argument(0, NULL);
+	if(loops == 0) loops = 1000;
+
+	/* Enable the cycle counter
+	 ------------------------------------------------------*/
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* Create uncontended objects
+	 ------------------------------------------------------*/
+	os_handle_t mutex;
+	os_handle_t sem;
+	if(os_mutex_create(&mutex, NULL) != OS_ERR_OK){
+		PRINTLN("Could not create mutex");
+		return;
+	}
+	if(os_sem_create(&sem, 1, 1, NULL) != OS_ERR_OK){
+		os_mutex_delete(mutex);
+		PRINTLN("Could not create semaphore");
+		return;
+	}
+
+	/* Feedback, in CPU cycles per take + release
+	 ------------------------------------------------------*/
+	PRINTLN("Cycles per take + release, %lu loops", loops);
+	PRINTLN("mutex : fast %lu, generic %lu", bench_run(mutex, true, loops), bench_run(mutex, false, loops));
+	PRINTLN("sem   : fast %lu, generic %lu", bench_run(sem, true, loops), bench_run(sem, false, loops));
+
+	os_sem_delete(sem);
+	os_mutex_delete(mutex);
+}
+
 /**********************************************************
  * GLOBAL VARIABLES
  **********************************************************/
 
 cliElement_t cliSystem[] = {
 		cliActionElementDetailed("reset", 	reset, 	"", 	"Reset device",  		NULL),
+		cliActionElementDetailed("bench", 	bench, 	"u", 	"Measures the cycles of an uncontended mutex / semaphore take + release, fast path against generic wait",  		NULL),
 		cliMenuTerminator()
 };
 
@@ -39,9 +39,14 @@ static void top(){
 	PRINTLN("");
 	PRINTLN("Memory usage, Used = %lu, Free = %lu, Total = %lu, Used Perc = %lu.%lu %%", mon.used_size, mon.total_size - mon.used_size, mon.total_size, mon.used_size * 100 / mon.total_size, mon.used_size * 10000 / mon.total_size % 100);
 	PRINTLN("Curent Tasks : ");
-	PRINTLN("PID       name");
+	PRINTLN("PID       thr     heap        stack       cpu     cpu time    name");
 	while(it != NULL){
-		PRINTLN("%05d     %-10s", (int)((os_process_t*)it->element)->PID, ((os_process_t*)it->element)->p_name == NULL ? "No name" : ((os_process_t*)it->element)->p_name);
+		os_process_t* p = (os_process_t*)it->element;
+		os_process_usage_t usage;
+		os_process_getUsage(p, &usage);
+
+		PRINTLN("%05d     %03lu     %-10lu  %-10lu  %03d%%%c   %-10lu  %-10s", (int)p->PID, usage.threads, usage.heapBytes, usage.stackBytes, (int)usage.cpuLoad, usage.throttled ? '*' : ' ',
+												usage.cpuTicks, p->p_name == NULL ? "No name" : p->p_name);
 		it = it->next;
 	}
 }
@@ -93,6 +98,22 @@ static void kill(){
 	}
 }
 
+static void exec_done(os_process_job_t* job){
+
+	/* Feedback, give the arguments back on error
+	 ------------------------------------------------------*/
+	if(job->ret != OS_ERR_OK){
+		PRINTLN("Error %ld", job->ret);
+
+		for(int i = 0; i < job->argc; i++)
+			os_heap_free(job->argv[i]);
+
+		os_heap_free(job->argv);
+	}
+	else
+		PRINTLN("Process PID %d created OK", job->PID);
+}
+
 static void exec(){
 
 	/* Count arguments
@@ -172,14 +193,53 @@ static void exec(){
 		argc++;
 	}
 
-	/* Create process
+	/* Create process in background, the CLI stays responsive while it loads
 	 ------------------------------------------------------*/
-	os_err_e err = os_process_create(argv[0], argc, argv);
+	os_err_e err = os_process_createAsync(argv[0], argc, argv, exec_done, NULL, NULL);
 	if(err != OS_ERR_OK){
 		PRINTLN("Error %ld", err);
+
+		/* The job was not queued, the arguments are still ours
+		 ------------------------------------------------------*/
+		for(int i = 0; i < argc; i++)
+			os_heap_free(argv[i]);
+
+		os_heap_free(argv);
+	}
+	else
+		PRINTLN("Loading %s", argv[0]);
+}
+
+static void install(){
+
+	/* Get argument
+	 ------------------------------------------------------*/
+	char file[OS_XIP_NAME_LEN];
+	cli_get_string_argument(0, (uint8_t*)file, sizeof(file), NULL);
+
+	/* Install text
+	 ------------------------------------------------------*/
+	os_err_e err = os_process_install(file);
+	if(err != OS_ERR_OK){
+		PRINTLN("Error %ld", err);
+	}
+	else
+		PRINTLN("%s installed OK", file);
+}
+
+static void uninstall(){
+
+	/* Erase every installed text
+	 ------------------------------------------------------*/
+	os_err_e err = os_xip_clear();
+	if(err == OS_ERR_FORBIDDEN){
+		PRINTLN("A process is running installed text");
+	}
+	else if(err != OS_ERR_OK){
+		PRINTLN("Error %ld", err);
 	}
 	else
-		PRINTLN("Process created OK");
+		PRINTLN("Installed images erased");
 }
 
 /**********************************************************
@@ -187,10 +247,12 @@ static void exec(){
  **********************************************************/
 
 cliElement_t cliTasks[] = {
-		cliActionElementDetailed("top", 		top, 		"", 	"Lists all processes",  							NULL),
+		cliActionElementDetailed("top", 		top, 		"", 	"Lists all processes and their resource usage (* = throttled)", NULL),
 		cliActionElementDetailed("task_top", 	task_top, 	"", 	"Lists all tasks",  								NULL),
 		cliActionElementDetailed("kill", 		kill, 		"u", 	"Kill a task using PID",  							NULL),
 		cliActionElementDetailed("exec", 		exec, 		"s...", "Executes an ELF file, passing arguments. Integers are transformed in string format",  		NULL),
+		cliActionElementDetailed("install", 	install, 	"s", 	"Installs the text of an ELF file in flash, so that it is executed in place",  	NULL),
+		cliActionElementDetailed("uninstall", 	uninstall, 	"", 	"Erases every installed ELF text",  				NULL),
 		cliMenuTerminator()
 };
 
@@ -7,6 +7,7 @@
 
 #include "OS/OS_Core/OS.h"
 #include "OS/OS_Core/OS_Internal.h"
+#include "OS/OS_SL/os_sl.h"
 
 /**********************************************
  * PRIVATE VARIABLES
@@ -66,6 +67,13 @@ os_err_e os_init(char* main_name, int8_t main_task_priority, uint32_t interrput_
 	OS_FPU_STATUS_ENABLE();		//Allows FPU to indicate that it is active
 #endif
 
+	/* Init MPU for the stack guard (placed by the scheduler)
+	 ------------------------------------------------------*/
+#if defined(__OS_CORTEX_M4) && OS_STACK_GUARD_EN == 1
+	OS_MEMFAULT_ENABLE();		//Report guard hits as MemManage faults
+	OS_MPU_ENABLE();			//Default memory map for everything else
+#endif
+
 	/* Set priorities for pendSv and systick
 	 ------------------------------------------------------*/
 	OS_SYSTICK_DISABLE();
@@ -77,9 +85,15 @@ os_err_e os_init(char* main_name, int8_t main_task_priority, uint32_t interrput_
 	 ------------------------------------------------------*/
 	os_heap_clear();
 
+	/* Build shared library index
+	 ------------------------------------------------------*/
+	os_err_e ret = os_sl_init();
+	if(ret != OS_ERR_OK)
+		return ret;
+
 	/* Init Tasks
 	 ------------------------------------------------------*/
-	os_err_e ret = os_task_init(main_name, main_task_priority, interrput_stack_size, idle_stack_size);
+	ret = os_task_init(main_name, main_task_priority, interrput_stack_size, idle_stack_size);
 	if(ret != OS_ERR_OK)
 		return ret;
 
@@ -8,6 +8,7 @@
 #include "OS/OS_Core/OS_Common.h"
 #include "OS/OS_Core/OS_Obj.h"
 #include "OS/OS_Core/OS_Callbacks.h"
+#include "OS/OS_Core/OS_Tasks.h"
 
 /***********************************************************************
  * OS CALLBACKS
@@ -46,7 +47,8 @@ __weak void os_task_on_block_cb(os_handle_t h){
 /***********************************************************************
  * OS Idle task main funciton
  *
- * @brief This function is executed when the idle task is called (i.e) no other task is available
+ * @brief This function is executed when the idle task is called (i.e) no other task is available.
+ * It frees the tasks that deleted themselves; an override should call os_task_reap as well (task creations only free a few).
  *
  * @return : void* : generic return value
  *
@@ -54,6 +56,7 @@ __weak void os_task_on_block_cb(os_handle_t h){
 __weak void* os_idle_task_fn(void* arg){
 	UNUSED_ARG(arg);
 	while(1){
+		os_task_reap();
 	}
 }
 
@@ -83,3 +86,20 @@ __weak void os_insufficient_heap_cb(){
 	return;
 }
 
+
+/***********************************************************************
+ * OS Stack Overflow Callback
+ *
+ * @brief This function is called by the OS when the running task reached its stack guard (see OS_STACK_GUARD_EN).
+ * The fault handler halts once it returns
+ *
+ * ATTENTION : This function is called in fault context (MemManage or HardFault), the OS services cannot be used
+ *
+ * @param os_handle_t h : [in] Task that overflowed its stack
+ *
+ **********************************************************************/
+__weak void os_stack_overflow_cb(os_handle_t h){
+	UNUSED_ARG(h);
+	return;
+}
+
@@ -0,0 +1,330 @@
+/*
+ * OS_Cond.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_obj_head;	//Head to obj list
+extern os_list_cell_t* os_cur_task;	//Current task pointer
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Condition Variable get free count
+ *
+ * @brief Gets the number of wake ups available. A task that is not waiting yet never gets one, so late waiters cannot steal a signal.
+ *
+ * @param os_handle_t h 			: [in] object to verify the availability
+ * @param os_handle_t takingTask	: [in] task that would take the object (NULL to get the raw count)
+ *
+ * @return uint32_t : the amount of times the object can be taken
+ *
+ **********************************************************************/
+static uint32_t os_cond_getFreeCount(os_handle_t h, os_handle_t takingTask){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_cond_t* cond = os_cond_getFromHandle(h);
+	if(cond == NULL) return 0;
+
+	if(takingTask != NULL && os_list_search(h->blockList, takingTask) == NULL) return 0;
+
+	return cond->pending;
+}
+
+
+/***********************************************************************
+ * OS Condition Variable take
+ *
+ * @brief This function consumes one wake up
+ *
+ * @param os_handle_t h 			: [in] object to take
+ * @param os_handle_t takingTask	: [in] handle to the task that is taking the object
+ *
+ * @return os_err_e : 0 if OK
+ **********************************************************************/
+static os_err_e os_cond_objTake(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(takingTask);
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_cond_t* cond = os_cond_getFromHandle(h);
+	if(cond == NULL) return OS_ERR_BAD_ARG;
+	if(cond->pending == 0) return OS_ERR_BAD_ARG;
+
+	cond->pending--;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Condition Variable count waiters
+ *
+ * @brief Counts the live tasks waiting for the condition variable. Must be called in a critical section.
+ *
+ * @param os_handle_t h : [in] condition variable
+ *
+ * @return uint32_t : the number of waiting tasks
+ **********************************************************************/
+static uint32_t os_cond_countWaiters(os_handle_t h){
+	uint32_t n = 0;
+
+	for(os_list_cell_t* it = ((os_list_head_t*)h->blockList)->head.next; it != NULL; it = it->next){
+		os_task_t* t = (os_task_t*)it->element;
+
+		if(t->state != OS_TASK_DELETING && t->state != OS_TASK_ENDED)
+			n++;
+	}
+
+	return n;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Condition Variable Create
+ *
+ * @brief This function creates a condition variable. Signals sent while nobody waits are lost.
+ *
+ * @param os_handle_t* h 	: [out] handle to condition variable
+ * @param char* name		: [ in] condition variable name. If one with the same name already exists, its reference is returned. A null name always creates a nameless condition variable.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_create(os_handle_t* h, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(h == NULL) 							return OS_ERR_BAD_ARG;
+	if(os_init_get() == false)				return OS_ERR_NOT_READY;
+
+	/* If condition variable exists, return it
+	 ------------------------------------------------------*/
+	if(name != NULL){
+		os_list_cell_t* obj = os_handle_list_searchByName(&os_obj_head, OS_OBJ_COND, name);
+		if(obj != NULL){
+			*h = obj->element;
+			return OS_ERR_OK;
+		}
+	}
+
+	/* Alloc the condition variable block
+	 ------------------------------------------------------*/
+	os_cond_t* cond = (os_cond_t*)os_heap_alloc(sizeof(os_cond_t));
+
+	/* Check allocation
+	 ------------------------------------------------------*/
+	if(cond == 0) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init condition variable
+	 ------------------------------------------------------*/
+	cond->obj.type 			= OS_OBJ_COND;
+	cond->obj.objUpdate 	= 0;
+	cond->obj.getFreeCount	= os_cond_getFreeCount;
+	cond->obj.obj_take 		= os_cond_objTake;
+	cond->obj.blockList		= os_list_init();
+	cond->obj.waitSet		= NULL;
+	cond->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
+
+	/* Finish init
+	 ------------------------------------------------------*/
+	cond->pending			= 0;
+
+	/* Handles heap errors
+	 ------------------------------------------------------*/
+	if(cond->obj.blockList == NULL || (cond->obj.name == NULL && name != NULL) ){
+		os_list_clear(cond->obj.blockList);
+		os_heap_free(cond->obj.name);
+		os_heap_free(cond);
+
+		return OS_ERR_INSUFFICIENT_HEAP;
+	}
+
+	/* Copy name
+	 ------------------------------------------------------*/
+	if(name != NULL)
+		strcpy(cond->obj.name, name);
+
+	/* Add object to object list
+	 ------------------------------------------------------*/
+	os_err_e ret = os_list_add(&os_obj_head, (os_handle_t) cond, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) {
+		os_list_clear(cond->obj.blockList);
+		os_heap_free(cond->obj.name);
+		os_heap_free(cond);
+
+		return ret;
+	}
+
+	/* Return
+	 ------------------------------------------------------*/
+	*h = (os_handle_t)cond;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Condition Variable Wait
+ *
+ * @brief This function releases the mutex and blocks on the condition variable atomically, then takes the mutex back before returning
+ * (even on timeout). The mutex must be owned by the calling task. As with any condition variable, the predicate must be checked again after waking up.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the condition variable
+ * @param os_handle_t mutex 		: [ in] Handle to the mutex protecting the predicate
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait for a signal. OS_WAIT_FOREVER is accepted
+ *
+ * @return os_err_e OS_ERR_OK if signaled, OS_ERR_TIMEOUT if not signaled in time
+ **********************************************************************/
+os_err_e os_cond_wait(os_handle_t h, os_handle_t mutex, uint32_t timeout_ticks){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_cond_t* cond = os_cond_getFromHandle(h);
+	if(cond == NULL) 																return OS_ERR_BAD_ARG;
+	if(mutex == NULL || mutex->type != OS_OBJ_MUTEX) 								return OS_ERR_BAD_ARG;
+	if(os_mutex_getState(mutex) != OS_MUTEX_STATE_LOCKED) 							return OS_ERR_FORBIDDEN;
+	if(((os_mutex_t*)mutex)->owner != os_cur_task->element) 						return OS_ERR_FORBIDDEN;
+
+	/* Interrupts stay disabled from the release until the task is in the block list, so no signal can be lost in between.
+	 * Any switch requested by the release is only a pending PendSV until the wait blocks.
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Drop wake ups left by waiters that timed out
+	 ------------------------------------------------------*/
+	uint32_t waiters = os_cond_countWaiters(h);
+	if(cond->pending > waiters) cond->pending = waiters;
+
+	/* Release mutex and wait
+	 ------------------------------------------------------*/
+	os_mutex_release(mutex);
+
+	os_err_e err = OS_ERR_OK;
+	os_obj_single_wait(h, timeout_ticks, &err);
+
+	OS_EXIT_CRITICAL();
+
+	/* Take the mutex back, lending our priority to its owner if needed
+	 ------------------------------------------------------*/
+	os_err_e mutexErr = OS_ERR_OK;
+	os_obj_single_wait(mutex, OS_WAIT_FOREVER, &mutexErr);
+
+	return mutexErr != OS_ERR_OK ? mutexErr : err;
+}
+
+
+/***********************************************************************
+ * OS Condition Variable Signal
+ *
+ * @brief This function wakes up the highest priority task waiting for the condition variable, if any
+ *
+ * @param os_handle_t h : [ in] Handle to the condition variable
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_signal(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_cond_t* cond = os_cond_getFromHandle(h);
+	if(cond == NULL) return OS_ERR_BAD_ARG;
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Give one more wake up if someone is still without one
+	 ------------------------------------------------------*/
+	if(cond->pending >= os_cond_countWaiters(h)){
+		OS_EXIT_CRITICAL();
+		return OS_ERR_OK;
+	}
+
+	cond->pending++;
+
+	bool must_yield = os_handle_list_updateAndCheck(h);
+
+	/* Yield if necessary
+	 ------------------------------------------------------*/
+	if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+
+	OS_EXIT_CRITICAL();
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Condition Variable Broadcast
+ *
+ * @brief This function wakes up every task waiting for the condition variable
+ *
+ * @param os_handle_t h : [ in] Handle to the condition variable
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_broadcast(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_cond_t* cond = os_cond_getFromHandle(h);
+	if(cond == NULL) return OS_ERR_BAD_ARG;
+
+	/* Give a wake up to every waiting task
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		cond->pending = os_cond_countWaiters(h);
+
+		bool must_yield = cond->pending > 0 ? os_handle_list_updateAndCheck(h) : false;
+
+		/* Yield if necessary
+		 ------------------------------------------------------*/
+		if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+	);
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Condition Variable delete
+ *
+ * @brief This function deletes a condition variable. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the condition variable
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_cond_delete(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(os_cond_getFromHandle(h) == NULL) return OS_ERR_BAD_ARG;
+
+	/* Deletes from obj list and from its wait-set
+	 ------------------------------------------------------*/
+	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	os_list_clear(h->blockList);
+	os_heap_free(h->name);
+
+	return os_heap_free(h);
+}
@@ -142,6 +142,7 @@ os_err_e os_evt_create(os_handle_t* h, os_evt_reset_mode_e mode, char const * na
 	evt->obj.getFreeCount	= os_evt_getFreeCount;
 	evt->obj.obj_take		= os_evt_objTake;
 	evt->obj.blockList		= os_list_init();
+	evt->obj.waitSet		= NULL;
 	evt->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
 
 	/* Finish init
@@ -336,9 +337,10 @@ os_err_e os_evt_delete(os_handle_t h){
 	if(h == NULL) return OS_ERR_BAD_ARG;
 	if(h->type != OS_OBJ_EVT) return OS_ERR_BAD_ARG;
 
-	/* Deletes from obj list
+	/* Deletes from obj list and from its wait-set
 	 ------------------------------------------------------*/
 	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
 
 	/* Free memory
 	 ------------------------------------------------------*/
@@ -15,15 +15,27 @@
 
 typedef struct{
 	uint32_t addr_next;  //Address of next / previous block (max 0x20020000)
-	uint32_t block_used; //(0) Memory block free, (1) memory block occupied
+	uint32_t block_used; //(0) Memory block free, (1) memory block occupied, (2) memory block holding an arena
 } os_heap_header_t;
 
+typedef struct{
+	uint8_t* base;		 //First block of the region
+	uint32_t size;		 //Size of the region in bytes
+} os_heap_region_t;
+
+struct os_heap_arena_{
+	uint32_t size;		 //Size of the arena region in bytes (following this structure)
+	uint32_t reserved;	 //Keeps the region 8 bytes aligned
+};
+
 /**********************************************
  * PRIVATE VARIABLES
  *********************************************/
 
 static __align(8) uint8_t os_heap[OS_HEAP_SIZE];	//Heap memory block
 
+static os_heap_region_t const os_heap_global = { .base = os_heap, .size = sizeof(os_heap) };	//Region of the global heap
+
 /**********************************************
  * PRIVATE FUNCTIONS
  *********************************************/
@@ -33,14 +45,29 @@ static __align(8) uint8_t os_heap[OS_HEAP_SIZE];	//Heap memory block
  *
  * @brief This function calculates the size of the block (header + data)
  *
- * @param heap_header_t* p : [in] address of the header of the block
+ * @param os_heap_region_t const* r : [in] region containing the block
+ * @param heap_header_t* p 			: [in] address of the header of the block
  *
  * @return uint32_t : Size of the block in bytes (header + data)
  **********************************************************************/
-inline static uint32_t os_heap_BlockGetSize(os_heap_header_t const * p){
+inline static uint32_t os_heap_BlockGetSize(os_heap_region_t const* r, os_heap_header_t const * p){
 	if(p == NULL) return 0; //Avoid explosion
 
-	return ( (p->addr_next != 0) ? p->addr_next - (uint32_t)p : (uint32_t)&os_heap[sizeof(os_heap)] - (uint32_t)p ); //Calculate size in bytes
+	return ( (p->addr_next != 0) ? p->addr_next - (uint32_t)p : (uint32_t)&r->base[r->size] - (uint32_t)p ); //Calculate size in bytes
+}
+
+/***********************************************************************
+ * OS Get Arena Region
+ *
+ * @brief This function gets the region managed by an arena
+ *
+ * @param os_heap_arena_t* a : [in] arena
+ *
+ * @return os_heap_region_t : the region
+ **********************************************************************/
+inline static os_heap_region_t os_heap_ArenaGetRegion(os_heap_arena_t* a){
+	os_heap_region_t r = { .base = (uint8_t*)&a[1], .size = a->size };
+	return r;
 }
 
 /***********************************************************************
@@ -93,12 +120,13 @@ static void* os_heap_AllocateBeginning(os_heap_header_t* p, uint32_t size){
  *
  * @brief This function allocates at the end of a block, updating the list in the process
  *
- * @param heap_header_t* p : [in] address of the header of the block
- * @param uint32_t size    : [in] Size of the data part in bytes
+ * @param os_heap_region_t const* r : [in] region containing the block
+ * @param heap_header_t* p 			: [in] address of the header of the block
+ * @param uint32_t size    			: [in] Size of the data part in bytes
  *
  * @return void* : Address of the data part of the block
  **********************************************************************/
-static void* os_heap_AllocateEnd(os_heap_header_t* p, uint32_t size){
+static void* os_heap_AllocateEnd(os_heap_region_t const* r, os_heap_header_t* p, uint32_t size){
 
 	/* Check for argument errors
 	 ---------------------------------------------------*/
@@ -107,7 +135,7 @@ static void* os_heap_AllocateEnd(os_heap_header_t* p, uint32_t size){
 
 	/* Get references to manipulate
 	 ---------------------------------------------------*/
-	uint32_t block_size = os_heap_BlockGetSize(p);
+	uint32_t block_size = os_heap_BlockGetSize(r, p);
 	os_heap_header_t* oldTopHead = (os_heap_header_t*) (p);
 	os_heap_header_t* newBlock   = (os_heap_header_t*) ( (uint32_t)p + block_size - size - sizeof(os_heap_header_t) );
 
@@ -135,25 +163,18 @@ static void* os_heap_AllocateEnd(os_heap_header_t* p, uint32_t size){
 
 }
 
-/**********************************************
- * PUBLIC FUNCTIONS
- *********************************************/
-
 /***********************************************************************
- * OS Heap Clear
+ * OS Region Clear
  *
- * @brief This function clears the heap
+ * @brief This function turns a region into a single free block
  *
+ * @param os_heap_region_t const* r : [in] region to clear
  **********************************************************************/
-void os_heap_clear(){
-
-	/* Clear heap
-	 ---------------------------------------------------*/
-	memset(&os_heap, 0, sizeof(os_heap));
+static void os_heap_RegionClear(os_heap_region_t const* r){
 
 	/* Get header pointers
 	 ---------------------------------------------------*/
-	os_heap_header_t* p = (os_heap_header_t*) &os_heap[0];
+	os_heap_header_t* p = (os_heap_header_t*) &r->base[0];
 
 	/* Initialize headers
 	 ---------------------------------------------------*/
@@ -161,32 +182,23 @@ void os_heap_clear(){
 	p->addr_next  = 0; //Point outside of the heap to indicate end
 }
 
-
 /***********************************************************************
- * OS Heap Alloc
+ * OS Region Alloc
  *
- * @brief This function allocates an amount of bytes into the reserved heap
+ * @brief This function allocates an amount of bytes into a region. Must be called in a critical section
  *
- * @param uint32_t size : [in] Size to be allocated
+ * @param os_heap_region_t const* r : [in] region to allocate from
+ * @param uint32_t size 			: [in] Size to be allocated
  *
- * @return void* : Address of the memory block or NULL if the function failed (bad argument or not enough memory)
+ * @return os_heap_header_t* : Header of the allocated block or NULL if there is not enough memory
  **********************************************************************/
-void* os_heap_alloc(uint32_t size){
-
-	/* Check for argument errors
-	 ---------------------------------------------------*/
-	if(size == 0) return NULL;
-
-	/* If the task gets interrupted, the heap may be corrupted when it recovers
-	 ---------------------------------------------------*/
-	OS_DECLARE_IRQ_STATE;
-	OS_ENTER_CRITICAL();
+static os_heap_header_t* os_heap_RegionAlloc(os_heap_region_t const* r, uint32_t size){
 
 	/* Declare variables to get the tiniest block that has the size required
 	 ---------------------------------------------------*/
 	os_heap_header_t* pBlock = NULL;
 	uint32_t min_size = 0xFFFFFFFF;
-	os_heap_header_t* p = (os_heap_header_t*) &os_heap[0];
+	os_heap_header_t* p = (os_heap_header_t*) &r->base[0];
 
 	/* Search for entire list
 	 ---------------------------------------------------*/
@@ -195,7 +207,7 @@ void* os_heap_alloc(uint32_t size){
 
 		/* If the block is free, it's big enough and it's smaller than the previous, save it
 		 ---------------------------------------------------*/
-		uint32_t data_size = os_heap_BlockGetSize(p) - sizeof(os_heap_header_t);
+		uint32_t data_size = os_heap_BlockGetSize(r, p) - sizeof(os_heap_header_t);
 		if(p->block_used == 0 && data_size < min_size && data_size >= totalSize) {
 			pBlock = p;
 			min_size = data_size;
@@ -206,57 +218,44 @@ void* os_heap_alloc(uint32_t size){
 		p = (os_heap_header_t*) ( p->addr_next );
 	}
 
-	/* If pBlock is outside the heap, there is no memory available
+	/* If pBlock is outside the region, there is no memory available
 	 ---------------------------------------------------*/
-	if(!(&os_heap[0] <= (uint8_t*)pBlock && (uint8_t*)pBlock <= &os_heap[sizeof(os_heap) - 1] ) ) {
-
-		/* Execute callback
-		 ---------------------------------------------------*/
-		os_insufficient_heap_cb();
-		OS_EXIT_CRITICAL();
+	if(!(&r->base[0] <= (uint8_t*)pBlock && (uint8_t*)pBlock <= &r->base[r->size - 1] ) ) {
 		return NULL;
 	}
 
 	/* If pBlock is not NULL, reserve a memory block
 	 ---------------------------------------------------*/
-	void* ret = ( (totalSize < OS_HEAP_BIG_BLOCK_THRESHOLD) ? os_heap_AllocateBeginning(pBlock, totalSize) : os_heap_AllocateEnd(pBlock, totalSize) );
-	OS_EXIT_CRITICAL();
-	return ret;
-
+	void* ret = ( (totalSize < OS_HEAP_BIG_BLOCK_THRESHOLD) ? os_heap_AllocateBeginning(pBlock, totalSize) : os_heap_AllocateEnd(r, pBlock, totalSize) );
+	return ret == NULL ? NULL : (os_heap_header_t*)( (uint32_t)ret - sizeof(os_heap_header_t) );
 }
 
-
 /***********************************************************************
- * OS Heap Free
+ * OS Region Free
  *
- * @brief This function frees a memory block previously allocated my OS_Heap_Alloc
+ * @brief This function frees a memory block of a region. Blocks holding an arena forward the free to the arena. Must be called in a critical section
  *
- * @param void* p : [in] Pointer to the data as given by Alloc
+ * @param os_heap_region_t const* r : [in] region containing the block
+ * @param void* p 					: [in] Pointer to the data as given by Alloc
  *
- * @return OS_ERR_OK if OK
+ * @return OS_ERR_OK if OK, OS_ERR_INVALID if p was not given by Alloc or is already free
  **********************************************************************/
-os_err_e os_heap_free(void* p){
+static os_err_e os_heap_RegionFree(os_heap_region_t const* r, void* p){
 
 	/* Check for argument errors
 	 ---------------------------------------------------*/
-	if(p == NULL) return OS_ERR_BAD_ARG;
-	if( !(&os_heap[sizeof(os_heap_header_t)] <= (uint8_t*)p && (uint8_t*)p <= &os_heap[sizeof(os_heap) - 1] ) ) return OS_ERR_BAD_ARG;
-
-	/* If the task gets interrupted, the heap may be corrupted when it recovers
-	 ---------------------------------------------------*/
-	OS_DECLARE_IRQ_STATE;
-	OS_ENTER_CRITICAL();
+	if( !(&r->base[sizeof(os_heap_header_t)] <= (uint8_t*)p && (uint8_t*)p <= &r->base[r->size - 1] ) ) return OS_ERR_BAD_ARG;
 
 	/* Declare Current block and target block
 	 ---------------------------------------------------*/
-	os_heap_header_t* cur   = (os_heap_header_t*)(&os_heap[0]);
+	os_heap_header_t* cur   = (os_heap_header_t*)(&r->base[0]);
 
 	/* Declare auxiliary pointers to help deleting
 	 ---------------------------------------------------*/
 	os_heap_header_t* pNext = NULL;
 	os_heap_header_t* pPrev = NULL;
 
-	/* Search for the target block while still inside the heap
+	/* Search for the target block while still inside the region
 	 ---------------------------------------------------*/
 	bool inBounds = false;
 	bool BlockFound = false;
@@ -264,7 +263,7 @@ os_err_e os_heap_free(void* p){
 
 		/* Calculate if out of bounds of block found
 		 ---------------------------------------------------*/
-		inBounds = (uint32_t)&os_heap[0] <= (uint32_t)cur && (uint32_t)cur <= (uint32_t)&os_heap[sizeof(os_heap) - 1];
+		inBounds = (uint32_t)&r->base[0] <= (uint32_t)cur && (uint32_t)cur <= (uint32_t)&r->base[r->size - 1];
 		BlockFound = (uint32_t)cur <= (uint32_t)p && (cur->addr_next == 0 || (uint32_t)p <= (uint32_t)cur->addr_next );
 
 		/* Break if we finished searching
@@ -277,10 +276,23 @@ os_err_e os_heap_free(void* p){
 		cur = (os_heap_header_t*) ( cur->addr_next );
 	}
 
-	/* If the block was not found, or the block is outside the heap, return
+	/* If the block was not found, or the block is outside the region, return
 	 ---------------------------------------------------*/
 	if( !BlockFound || !inBounds ) {
-		OS_EXIT_CRITICAL();
+		return OS_ERR_INVALID;
+	}
+
+	/* Memory given by an arena, free it there
+	 ---------------------------------------------------*/
+	os_heap_arena_t* arena = (os_heap_arena_t*)( (uint32_t)cur + sizeof(os_heap_header_t) );
+	if(cur->block_used == 2 && (uint8_t*)p > (uint8_t*)arena){
+		os_heap_region_t sub = os_heap_ArenaGetRegion(arena);
+		return os_heap_RegionFree(&sub, p);
+	}
+
+	/* Only the pointer given by Alloc frees a block (arenas are freed by os_heap_arenaDelete)
+	 ---------------------------------------------------*/
+	if(cur->block_used != 1 || p != (void*)arena) {
 		return OS_ERR_INVALID;
 	}
 
@@ -303,44 +315,39 @@ os_err_e os_heap_free(void* p){
 		cur->addr_next = 0; //For principle, but not necessary
 	}
 
-	OS_EXIT_CRITICAL();
 	return OS_ERR_OK;
 }
 
-
 /***********************************************************************
- * OS Heap Monitor
+ * OS Region Monitor
  *
- * @brief This function returns data about the heap's utilization
+ * @brief This function computes data about a region's utilization. Must be called in a critical section
  *
- * @return os_heap_mon_t : Struct containing heap info
+ * @param os_heap_region_t const* r : [in] region to monitor
+ *
+ * @return os_heap_mon_t : Struct containing region info
  **********************************************************************/
-os_heap_mon_t os_heap_monitor(){
+static os_heap_mon_t os_heap_RegionMonitor(os_heap_region_t const* r){
 
 	/* Declare Return structure
 	 ---------------------------------------------------*/
 	os_heap_mon_t ret;
 	memset(&ret, 0, sizeof(ret));
-	ret.total_size = sizeof(os_heap);
-
-	/* If the task gets interrupted, the heap may be corrupted when it recovers
-	 ---------------------------------------------------*/
-	OS_DECLARE_IRQ_STATE;
-	OS_ENTER_CRITICAL();
+	ret.total_size = r->size;
 
 	/* Declare iterators
 	 ---------------------------------------------------*/
 	os_heap_header_t* pPrev = NULL;
 	os_heap_header_t* pNext = NULL;
-	os_heap_header_t* cur = (os_heap_header_t*)(&os_heap[0]);
+	os_heap_header_t* cur = (os_heap_header_t*)(&r->base[0]);
 
-	/* Search all heap
+	/* Search all region
 	 ---------------------------------------------------*/
 	while(cur != NULL){
 
 		/* Calculate block size
 		 ---------------------------------------------------*/
-		uint32_t block_sz = os_heap_BlockGetSize(cur);
+		uint32_t block_sz = os_heap_BlockGetSize(r, cur);
 
 		/* Get reference to next block
 		 ---------------------------------------------------*/
@@ -348,14 +355,14 @@ os_heap_mon_t os_heap_monitor(){
 
 		/* Calculate if next and previous blocks are used
 		 ---------------------------------------------------*/
-		uint8_t prev_block_used = ( (pPrev != NULL) && (pPrev->block_used == 1) );
-		uint8_t next_block_used = ( (pNext != NULL) && (pNext->block_used == 1) );
+		uint8_t prev_block_used = ( (pPrev != NULL) && (pPrev->block_used != 0) );
+		uint8_t next_block_used = ( (pNext != NULL) && (pNext->block_used != 0) );
 
 		/* Update return Data
 		 ---------------------------------------------------*/
-		ret.used_size += ( (cur->block_used == 1) ? block_sz : 0 );
+		ret.used_size += ( (cur->block_used != 0) ? block_sz : 0 );
 		ret.fragmented_size += ( ( (next_block_used == 1) && (prev_block_used == 1) && (cur->block_used == 0) ) ? block_sz : 0 );
-		ret.biggest_block_size = ( (cur->block_used == 1) && (block_sz > ret.biggest_block_size) ? block_sz : ret.biggest_block_size );
+		ret.biggest_block_size = ( (cur->block_used != 0) && (block_sz > ret.biggest_block_size) ? block_sz : ret.biggest_block_size );
 
 		/* Update iterator
 		 ---------------------------------------------------*/
@@ -363,8 +370,282 @@ os_heap_mon_t os_heap_monitor(){
 		cur = pNext;
 	}
 
+	return ret;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Heap Clear
+ *
+ * @brief This function clears the heap
+ *
+ **********************************************************************/
+void os_heap_clear(){
+
+	/* Clear heap
+	 ---------------------------------------------------*/
+	memset(&os_heap, 0, sizeof(os_heap));
+
+	/* Initialize headers
+	 ---------------------------------------------------*/
+	os_heap_RegionClear(&os_heap_global);
+}
+
+
+/***********************************************************************
+ * OS Heap Alloc
+ *
+ * @brief This function allocates an amount of bytes into the reserved heap
+ *
+ * @param uint32_t size : [in] Size to be allocated
+ *
+ * @return void* : Address of the memory block or NULL if the function failed (bad argument or not enough memory)
+ **********************************************************************/
+void* os_heap_alloc(uint32_t size){
+
+	/* Check for argument errors
+	 ---------------------------------------------------*/
+	if(size == 0) return NULL;
+
+	/* If the task gets interrupted, the heap may be corrupted when it recovers
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_heap_header_t* block = os_heap_RegionAlloc(&os_heap_global, size);
+
+	/* Execute callback if there is no memory available
+	 ---------------------------------------------------*/
+	if(block == NULL) {
+		os_insufficient_heap_cb();
+		OS_EXIT_CRITICAL();
+		return NULL;
+	}
+
+	OS_EXIT_CRITICAL();
+	return (void*) ( (uint32_t)block + sizeof(os_heap_header_t) );
+
+}
+
+
+/***********************************************************************
+ * OS Heap Free
+ *
+ * @brief This function frees a memory block previously allocated my OS_Heap_Alloc or os_heap_arenaAlloc
+ *
+ * @param void* p : [in] Pointer to the data as given by Alloc
+ *
+ * @return OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_heap_free(void* p){
+
+	/* Check for argument errors
+	 ---------------------------------------------------*/
+	if(p == NULL) return OS_ERR_BAD_ARG;
+
+	/* If the task gets interrupted, the heap may be corrupted when it recovers
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_err_e ret = os_heap_RegionFree(&os_heap_global, p);
+
+	OS_EXIT_CRITICAL();
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS Heap Monitor
+ *
+ * @brief This function returns data about the heap's utilization
+ *
+ * @return os_heap_mon_t : Struct containing heap info
+ **********************************************************************/
+os_heap_mon_t os_heap_monitor(){
+
+	/* If the task gets interrupted, the heap may be corrupted when it recovers
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_heap_mon_t ret = os_heap_RegionMonitor(&os_heap_global);
+
 	/* Return data
 	 ---------------------------------------------------*/
 	OS_EXIT_CRITICAL();
 	return ret;
 }
+
+
+/***********************************************************************
+ * OS Heap Arena Create
+ *
+ * @brief This function reserves a block of the heap to serve the allocations of a single owner
+ *
+ * @param uint32_t size : [in] Amount of bytes the arena can serve (block headers included, 8 bytes per allocation)
+ *
+ * @return os_heap_arena_t* : the arena, NULL if there is not enough memory
+ **********************************************************************/
+os_heap_arena_t* os_heap_arenaCreate(uint32_t size){
+
+	/* Check for argument errors
+	 ---------------------------------------------------*/
+	if(size < 2 * sizeof(os_heap_header_t)) return NULL;
+
+	size = (size + 8U - 1U) & ~(8U - 1U);
+
+	/* Reserve the block and tag it as an arena
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_heap_header_t* block = os_heap_RegionAlloc(&os_heap_global, sizeof(os_heap_arena_t) + size);
+	if(block == NULL){
+		os_insufficient_heap_cb();
+		OS_EXIT_CRITICAL();
+		return NULL;
+	}
+
+	block->block_used = 2;
+
+	OS_EXIT_CRITICAL();
+
+	/* Init the arena region
+	 ---------------------------------------------------*/
+	os_heap_arena_t* a = (os_heap_arena_t*)( (uint32_t)block + sizeof(os_heap_header_t) );
+	a->size = size;
+	a->reserved = 0;
+
+	os_heap_region_t r = os_heap_ArenaGetRegion(a);
+	os_heap_RegionClear(&r);
+
+	return a;
+}
+
+
+/***********************************************************************
+ * OS Heap Arena Alloc
+ *
+ * @brief This function allocates an amount of bytes into an arena. The block is freed with os_heap_free, or when the arena is deleted
+ *
+ * @param os_heap_arena_t* a 	: [in] Arena
+ * @param uint32_t size 		: [in] Size to be allocated
+ *
+ * @return void* : Address of the memory block or NULL if the function failed (bad argument or not enough memory in the arena)
+ **********************************************************************/
+void* os_heap_arenaAlloc(os_heap_arena_t* a, uint32_t size){
+
+	/* Check for argument errors
+	 ---------------------------------------------------*/
+	if(a == NULL) return NULL;
+	if(size == 0) return NULL;
+
+	/* The arena is a heap on its own, only its owner contends for it
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_heap_region_t r = os_heap_ArenaGetRegion(a);
+	os_heap_header_t* block = os_heap_RegionAlloc(&r, size);
+
+	OS_EXIT_CRITICAL();
+	return block == NULL ? NULL : (void*) ( (uint32_t)block + sizeof(os_heap_header_t) );
+}
+
+
+/***********************************************************************
+ * OS Heap Arena Monitor
+ *
+ * @brief This function returns data about an arena's utilization
+ *
+ * @param os_heap_arena_t* a : [in] Arena
+ *
+ * @return os_heap_mon_t : Struct containing arena info
+ **********************************************************************/
+os_heap_mon_t os_heap_arenaMonitor(os_heap_arena_t* a){
+
+	os_heap_mon_t ret;
+	memset(&ret, 0, sizeof(ret));
+
+	if(a == NULL) return ret;
+
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_heap_region_t r = os_heap_ArenaGetRegion(a);
+	ret = os_heap_RegionMonitor(&r);
+
+	OS_EXIT_CRITICAL();
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS Heap Arena Block Size
+ *
+ * @brief This function gets the size of a block allocated in an arena
+ *
+ * @param os_heap_arena_t* a 	: [in] Arena
+ * @param void const* p 		: [in] Address given by os_heap_arenaAlloc
+ *
+ * @return uint32_t : Size of the block (header included), 0 if p is not an allocated block of the arena
+ **********************************************************************/
+uint32_t os_heap_arenaBlockSize(os_heap_arena_t* a, void const* p){
+
+	/* Check for argument errors
+	 ---------------------------------------------------*/
+	if(a == NULL || p == NULL) return 0;
+
+	os_heap_region_t r = os_heap_ArenaGetRegion(a);
+	if( !(&r.base[sizeof(os_heap_header_t)] <= (uint8_t const*)p && (uint8_t const*)p <= &r.base[r.size - 1] ) ) return 0;
+
+	/* The header is right before the data part
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_heap_header_t const* block = (os_heap_header_t const*)( (uint32_t)p - sizeof(os_heap_header_t) );
+	uint32_t size = block->block_used == 1 ? os_heap_BlockGetSize(&r, block) : 0;
+
+	OS_EXIT_CRITICAL();
+	return size;
+}
+
+
+/***********************************************************************
+ * OS Heap Arena Delete
+ *
+ * @brief This function gives an arena back to the heap, with every block still allocated in it
+ *
+ * @param os_heap_arena_t* a : [in] Arena
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_heap_arenaDelete(os_heap_arena_t* a){
+
+	/* Check for argument errors
+	 ---------------------------------------------------*/
+	if(a == NULL) return OS_ERR_BAD_ARG;
+
+	os_heap_header_t* block = (os_heap_header_t*)( (uint32_t)a - sizeof(os_heap_header_t) );
+
+	/* Tag it as a normal block and free it
+	 ---------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	if(block->block_used != 2){
+		OS_EXIT_CRITICAL();
+		return OS_ERR_INVALID;
+	}
+
+	block->block_used = 1;
+	os_err_e ret = os_heap_RegionFree(&os_heap_global, a);
+
+	OS_EXIT_CRITICAL();
+	return ret;
+}
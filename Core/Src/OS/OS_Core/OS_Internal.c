@@ -49,6 +49,10 @@ static bool os_mutex_udpatePrio(os_handle_t h){
 	os_mutex_t* mutex = (os_mutex_t*)h;
 	int8_t prev_max_prio = mutex->max_prio;
 
+	/* A ceiling mutex always lends its ceiling, waiters are never scanned
+	 ---------------------------------------------------*/
+	if(mutex->ceiling >= 0) return false;
+
 	/* Get reference to the first blocked task
 	 ---------------------------------------------------*/
 	int8_t maxPrio = -1;
@@ -69,9 +73,54 @@ static bool os_mutex_udpatePrio(os_handle_t h){
 		it = it->next;
 	}
 
+	/* A mutex taken through the fast path joins its owner's list only once someone waits for it
+	 ---------------------------------------------------*/
+	bool listed = false;
+	if(maxPrio >= 0 && mutex->state == OS_MUTEX_STATE_LOCKED && mutex->ownerListed == false && mutex->owner != NULL){
+		listed = os_list_add( ((os_task_t*)mutex->owner)->ownedMutex, h, OS_LIST_FIRST) == OS_ERR_OK;
+		mutex->ownerListed = listed;
+	}
+
 	/* Store priority and return
 	 ---------------------------------------------------*/
 	mutex->max_prio = maxPrio;
+	return prev_max_prio != maxPrio || listed;
+}
+
+
+/***********************************************************************
+ * OS RW Lock Update Prio
+ *
+ * @brief This function updates the maximum priority of the tasks waiting for a reader-writer lock
+ *
+ * @param os_handle_t h : [in] The reference to the lock
+ *
+ * @return bool : (1) = priority changed; (0) = Nothing changed
+ *
+ **********************************************************************/
+static bool os_rwlock_udpatePrio(os_handle_t h){
+
+	/* Error Check
+	 ---------------------------------------------------*/
+	if(h == NULL) return false;
+	if(h->type != OS_OBJ_RWLOCK) return false;
+
+	/* Convet reference and store previous priority
+	 ---------------------------------------------------*/
+	os_rwlock_t* rw = (os_rwlock_t*)h;
+	int8_t prev_max_prio = rw->max_prio;
+
+	/* Calculate the maximum priority of the blocked tasks
+	 ---------------------------------------------------*/
+	int8_t maxPrio = -1;
+	for(os_list_cell_t* it = ((os_list_head_t*)h->blockList)->head.next; it != NULL; it = it->next){
+		int8_t taskPrio = ((os_task_t*)it->element)->priority;
+		if(maxPrio < taskPrio) maxPrio = taskPrio;
+	}
+
+	/* Store priority and return
+	 ---------------------------------------------------*/
+	rw->max_prio = maxPrio;
 	return prev_max_prio != maxPrio;
 }
 
@@ -98,9 +147,13 @@ static bool os_task_udpatePrio(os_handle_t h){
 	os_task_t* tsk = (os_task_t*)h;
 	int8_t prev_prio = tsk->priority;
 
-	/* Point to the first task on block list
+	/* Start from the base priority, demoted while the process of the task is throttled
 	 ---------------------------------------------------*/
 	int8_t maxPrio = tsk->basePriority;
+	if(tsk->process != NULL && tsk->process->usage.throttled && maxPrio > OS_PROCESS_THROTTLE_PRIO) maxPrio = OS_PROCESS_THROTTLE_PRIO;
+
+	/* Point to the first task on block list
+	 ---------------------------------------------------*/
 	os_list_head_t* head = (os_list_head_t*)h->blockList;
 	os_list_cell_t* it = head->head.next;
 
@@ -123,13 +176,14 @@ static bool os_task_udpatePrio(os_handle_t h){
 	head = (os_list_head_t*) ( ((os_task_t*)h)->ownedMutex);
 	it = head->head.next;
 
-	/* While it is a valid mutex
+	/* While it is a valid mutex (or reader-writer lock held for writing)
 	 ---------------------------------------------------*/
 	while(it != NULL){
 
 		/* Get mutex' priority and calculate maximum
 		 ---------------------------------------------------*/
-		int8_t taskPrio = ((os_mutex_t*)it->element)->max_prio;
+		os_handle_t owned = (os_handle_t)it->element;
+		int8_t taskPrio = owned->type == OS_OBJ_RWLOCK ? ((os_rwlock_t*)owned)->max_prio : ((os_mutex_t*)owned)->max_prio;
 		if(maxPrio < taskPrio) maxPrio = taskPrio;
 
 		/* Goes to next mutex
@@ -167,6 +221,12 @@ void os_obj_updatePrio(os_handle_t h){
 		os_obj_updatePrio(((os_mutex_t*)h)->owner); //Update its owner priority if the mutex's priority changed
 	}
 
+	/* If the object is a reader-writer lock, update its priority and lend it to the writer
+	 ---------------------------------------------------*/
+	if(h->type == OS_OBJ_RWLOCK && os_rwlock_udpatePrio(h) && ((os_rwlock_t*)h)->writer != NULL){
+		os_obj_updatePrio(((os_rwlock_t*)h)->writer);
+	}
+
 	/* If the object is a task, update its priority
 	 ---------------------------------------------------*/
 	if(h->type == OS_OBJ_TASK && os_task_udpatePrio(h)){
@@ -175,9 +235,10 @@ void os_obj_updatePrio(os_handle_t h){
 		 ---------------------------------------------------*/
 		for(size_t i = 0; i < ((os_task_t*)h)->sizeObjs; i++){
 
-			/* objects that are not tasks or mutexes
+			/* objects that are not tasks, mutexes or reader-writer locks
 			 ---------------------------------------------------*/
-			if(((os_task_t*)h)->objWaited[i]->type == OS_OBJ_MUTEX || ((os_task_t*)h)->objWaited[i]->type == OS_OBJ_TASK){
+			os_obj_type_e type = ((os_task_t*)h)->objWaited[i]->type;
+			if(type == OS_OBJ_MUTEX || type == OS_OBJ_TASK || type == OS_OBJ_RWLOCK){
 
 				/* Update object's priority
 				 ---------------------------------------------------*/
@@ -317,11 +378,10 @@ os_list_cell_t* os_handle_list_searchByName(os_list_head_t* head, os_obj_type_e
 	if(head == NULL) return NULL;
 	if(name == NULL) return NULL;
 
-	/* Enter Critical Section
-	 * If it's searching / inserting a block, it can be interrupted and another task can change the list. In this case, the first task will blow up when returning
+	/* Lock scheduler
+	 * Handle lists only change at task level, so other tasks must be kept away, but interrupts can still run during the string compares
 	 ------------------------------------------------------*/
-	OS_DECLARE_IRQ_STATE;
-	OS_ENTER_CRITICAL();
+	os_scheduler_lock();
 
 	/* Search list
 	 ------------------------------------------------------*/
@@ -337,7 +397,7 @@ os_list_cell_t* os_handle_list_searchByName(os_list_head_t* head, os_obj_type_e
 		it = it->next;
 	}
 
-	OS_EXIT_CRITICAL();
+	os_scheduler_unlock();
 	return it;
 }
 
@@ -732,10 +792,10 @@ bool os_task_list_isObjFreeOnTask(os_handle_t obj, os_handle_t task){
 	OS_DECLARE_IRQ_STATE;
 	OS_ENTER_CRITICAL();
 
-	/* Get current free count and return if topic
+	/* Get current free count and return if topic, wait-set or reader-writer lock (their count depends on the task)
 	 ---------------------------------------------------*/
 	uint32_t freeCount = obj->getFreeCount(obj, task);
-	if(obj->type == OS_OBJ_TOPIC){
+	if(obj->type == OS_OBJ_TOPIC || obj->type == OS_OBJ_WAITSET || obj->type == OS_OBJ_RWLOCK){
         OS_EXIT_CRITICAL();
 		return freeCount > 0;
     }
@@ -860,7 +920,8 @@ bool os_handle_list_updateAndCheck(os_handle_t h){
 
 		/* Get the number of times we can get the object
 		 ---------------------------------------------------*/
-		uint32_t freeCount = h->type == OS_OBJ_TOPIC ? 0 : h->getFreeCount(h, NULL);
+		bool perTaskCount = h->type == OS_OBJ_TOPIC || h->type == OS_OBJ_WAITSET || h->type == OS_OBJ_RWLOCK;
+		uint32_t freeCount = perTaskCount ? 0 : h->getFreeCount(h, NULL);
 
 		/* Updates every task on the block list
 		 ---------------------------------------------------*/
@@ -871,7 +932,7 @@ bool os_handle_list_updateAndCheck(os_handle_t h){
 			os_task_t* t = (os_task_t*)it->element;
 			if(t->state == OS_TASK_DELETING || t->state == OS_TASK_ENDED) continue;
 
-			if(h->type == OS_OBJ_TOPIC){
+			if(perTaskCount){
 				freeCount = h->getFreeCount(h, (os_handle_t) t);
 			}
 
@@ -1015,6 +1076,10 @@ bool os_handle_list_updateAndCheck(os_handle_t h){
 		 ---------------------------------------------------*/
 		h->objUpdate = 0;
 
+		/* The wait-set holding this object must re-evaluate its waiting tasks too
+		 ---------------------------------------------------*/
+		if(h->waitSet != NULL) h->waitSet->objUpdate = 1;
+
 		/* Search for another object in the object list that needs to update.
 		 * This logic is important for 2 reasons
 		 *
@@ -0,0 +1,73 @@
+/*
+ * OS_KData.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_head;	//Head to task list
+
+/**********************************************
+ * PRIVATE VARIABLES
+ *********************************************/
+
+static os_kdata_t os_kdata __attribute__((aligned(32)));	//Kernel data page (aligned so an MPU region can cover it once processes run unprivileged)
+
+/**********************************************
+ * OS PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Kernel Data Set Tick
+ *
+ * @brief This function publishes the tick counter. Must be called with interrupts disabled
+ *
+ * @param uint32_t msTick : [in] Tick counter in ms
+ **********************************************************************/
+void os_kdata_setTick(uint32_t msTick){
+	os_kdata.seq++;
+	os_kdata.msTick = msTick;
+	os_kdata.seq++;
+}
+
+
+/***********************************************************************
+ * OS Kernel Data Set Task
+ *
+ * @brief This function publishes the task chosen by the scheduler. Must be called with interrupts disabled
+ *
+ * @param os_handle_t task : [in] Task about to run
+ **********************************************************************/
+void os_kdata_setTask(os_handle_t task){
+	os_process_t* proc = ((os_task_t*)task)->process;
+
+	os_kdata.seq++;
+	os_kdata.curTask 	= task;
+	os_kdata.curPID 	= proc == NULL ? 0 : proc->PID;
+	os_kdata.nTasks 	= os_head.listSize;
+	os_kdata.ctxSwitches++;
+	os_kdata.seq++;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Kernel Data Get
+ *
+ * @brief This function returns the kernel data page
+ *
+ * @return os_kdata_t const* : reference to the page
+ **********************************************************************/
+os_kdata_t const* os_kdata_get(){
+	return &os_kdata;
+}
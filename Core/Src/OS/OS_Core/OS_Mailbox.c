@@ -0,0 +1,325 @@
+/*
+ * OS_Mailbox.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_obj_head;	//Head to obj list
+extern os_list_cell_t* os_cur_task;	//Current task pointer
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Mailbox get free count
+ *
+ * @brief Gets the amount of times the mailbox can be read before blocking
+ *
+ * @param os_handle_t h : [in] object to verify the availability
+ *
+ * @return uint32_t : the amount of times the object can be taken
+ *
+ **********************************************************************/
+static uint32_t os_mbox_getFreeCount(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(takingTask);
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_mbox_t* mbox = os_mbox_getFromHandle(h);
+	if(mbox == NULL) return 0;
+
+	return mbox->unread ? 1 : 0;
+}
+
+
+/***********************************************************************
+ * OS Mailbox take
+ *
+ * @brief Unused. The message is consumed by os_mbox_read
+ *
+ * @param os_handle_t h 			: [in] object to take
+ * @param os_handle_t takingTask	: [in] handle to the task that is taking the object
+ *
+ * @return os_err_e : 0 if OK
+ **********************************************************************/
+static os_err_e os_mbox_objTake(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(h);
+	UNUSED_ARG(takingTask);
+
+	return OS_ERR_OK;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Mailbox Create
+ *
+ * @brief This function creates a one-slot mailbox. A new post always overwrites the previous message, read or not.
+ *
+ * @param os_handle_t* h 	: [out] handle to mailbox
+ * @param char* name		: [ in] mailbox name. If a mailbox with the same name already exists, its reference is returned. A null name always creates a nameless mailbox.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mbox_create(os_handle_t* h, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(h == NULL) 							return OS_ERR_BAD_ARG;
+	if(os_init_get() == false)				return OS_ERR_NOT_READY;
+
+	/* If mailbox exists, return it
+	 ------------------------------------------------------*/
+	if(name != NULL){
+		os_list_cell_t* obj = os_handle_list_searchByName(&os_obj_head, OS_OBJ_MBOX, name);
+		if(obj != NULL){
+			*h = obj->element;
+			return OS_ERR_OK;
+		}
+	}
+
+	/* Alloc the mailbox block
+	 ------------------------------------------------------*/
+	os_mbox_t* mbox = (os_mbox_t*)os_heap_alloc(sizeof(os_mbox_t));
+
+	/* Check allocation
+	 ------------------------------------------------------*/
+	if(mbox == 0) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init mailbox
+	 ------------------------------------------------------*/
+	mbox->obj.type 			= OS_OBJ_MBOX;
+	mbox->obj.objUpdate 	= 0;
+	mbox->obj.getFreeCount	= os_mbox_getFreeCount;
+	mbox->obj.obj_take 		= os_mbox_objTake;
+	mbox->obj.blockList		= os_list_init();
+	mbox->obj.waitSet		= NULL;
+	mbox->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
+
+	/* Finish init
+	 ------------------------------------------------------*/
+	mbox->msg				= NULL;
+	mbox->seq				= 0;
+	mbox->unread			= false;
+
+	/* Handles heap errors
+	 ------------------------------------------------------*/
+	if(mbox->obj.blockList == NULL || (mbox->obj.name == NULL && name != NULL) ){
+		os_list_clear(mbox->obj.blockList);
+		os_heap_free(mbox->obj.name);
+		os_heap_free(mbox);
+
+		return OS_ERR_INSUFFICIENT_HEAP;
+	}
+
+	/* Copy name
+	 ------------------------------------------------------*/
+	if(name != NULL)
+		strcpy(mbox->obj.name, name);
+
+	/* Add object to object list
+	 ------------------------------------------------------*/
+	os_err_e ret = os_list_add(&os_obj_head, (os_handle_t) mbox, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) {
+		os_list_clear(mbox->obj.blockList);
+		os_heap_free(mbox->obj.name);
+		os_heap_free(mbox);
+
+		return ret;
+	}
+
+	/* Return
+	 ------------------------------------------------------*/
+	*h = (os_handle_t)mbox;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Mailbox Post
+ *
+ * @brief This function overwrites the mailbox message and increments its sequence number. Never allocates, so it can be called from interrupts.
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ * @param void* msg     : [ in] Reference to the message
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mbox_post(os_handle_t h, void* msg){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_mbox_t* mbox = os_mbox_getFromHandle(h);
+	if(mbox == NULL) return OS_ERR_BAD_ARG;
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Overwrite the slot. Sequence 0 is reserved for "never posted"
+	 ------------------------------------------------------*/
+	bool wasUnread = mbox->unread;
+
+	mbox->msg 		= msg;
+	mbox->seq 		= mbox->seq + 1 == 0 ? 1 : mbox->seq + 1;
+	mbox->unread 	= true;
+
+	/* Only the transition to unread can wake someone up
+	 ------------------------------------------------------*/
+	bool must_yield = wasUnread ? false : os_handle_list_updateAndCheck( (os_handle_t)mbox );
+
+	/* Yield if necessary
+	 ------------------------------------------------------*/
+	if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+
+	/* Exit
+	 ------------------------------------------------------*/
+	OS_EXIT_CRITICAL();
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Mailbox Read
+ *
+ * @brief This function reads the newest message of the mailbox and marks it as read
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ * @param uint32_t* seq : [out] Sequence number of the message read. NULL to ignore
+ * @param os_err_e* err : [out] Reference to the error code. OS_ERR_EMPTY if there is no unread message. NULL to ignore
+ *
+ * @return void* : the message or NULL if error
+ **********************************************************************/
+void* os_mbox_read(os_handle_t h, uint32_t* seq, os_err_e* err){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_mbox_t* mbox = os_mbox_getFromHandle(h);
+	if(mbox == NULL){
+		if(err != NULL)
+			*err = OS_ERR_BAD_ARG;
+
+		return NULL;
+	}
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Check if there is something new to read
+	 ------------------------------------------------------*/
+	if(mbox->unread == false){
+		OS_EXIT_CRITICAL();
+
+		if(err != NULL)
+			*err = OS_ERR_EMPTY;
+
+		return NULL;
+	}
+
+	/* Consume message
+	 ------------------------------------------------------*/
+	void* msg = mbox->msg;
+	if(seq != NULL)
+		*seq = mbox->seq;
+
+	mbox->unread = false;
+
+	/* Update block list
+	 ------------------------------------------------------*/
+	os_handle_list_updateAndCheck((os_handle_t)mbox);
+
+	OS_EXIT_CRITICAL();
+
+	if(err != NULL)
+		*err = OS_ERR_OK;
+
+	return msg;
+}
+
+
+/***********************************************************************
+ * OS Mailbox Peek
+ *
+ * @brief This function reads the newest message of the mailbox without marking it as read
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ * @param uint32_t* seq : [out] Sequence number of the message. NULL to ignore
+ * @param os_err_e* err : [out] Reference to the error code. OS_ERR_EMPTY if nothing was ever posted. NULL to ignore
+ *
+ * @return void* : the message or NULL if error
+ **********************************************************************/
+void* os_mbox_peek(os_handle_t h, uint32_t* seq, os_err_e* err){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_mbox_t* mbox = os_mbox_getFromHandle(h);
+	if(mbox == NULL){
+		if(err != NULL)
+			*err = OS_ERR_BAD_ARG;
+
+		return NULL;
+	}
+
+	/* Read message and sequence together
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	void* msg = mbox->msg;
+	uint32_t s = mbox->seq;
+
+	OS_EXIT_CRITICAL();
+
+	if(seq != NULL)
+		*seq = s;
+
+	if(err != NULL)
+		*err = s == 0 ? OS_ERR_EMPTY : OS_ERR_OK;
+
+	return msg;
+}
+
+
+/***********************************************************************
+ * OS Mailbox delete
+ *
+ * @brief This function deletes a mailbox. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the mailbox
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mbox_delete(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(os_mbox_getFromHandle(h) == NULL) return OS_ERR_BAD_ARG;
+
+	/* Deletes from obj list and from its wait-set
+	 ------------------------------------------------------*/
+	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	os_list_clear(h->blockList);
+	os_heap_free(h->name);
+
+	return os_heap_free(h);
+}
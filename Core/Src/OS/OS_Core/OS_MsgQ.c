@@ -53,6 +53,25 @@ static os_err_e os_msgQ_objTake(os_handle_t h, os_handle_t takingTask){
 	return OS_ERR_OK;
 }
 
+
+/***********************************************************************
+ * OS MsgQ clear priority lists
+ *
+ * @brief Frees every priority list and the list array of a PRIO queue
+ *
+ * @param os_msgQ_t* msgQ : [in] message queue
+ *
+ **********************************************************************/
+static void os_msgQ_clearPrioLists(os_msgQ_t* msgQ){
+	if(msgQ->prioList == NULL) return;
+
+	for(size_t i = 0; i < OS_MSGQ_PRIO_LEVELS; i++)
+		os_list_clear(msgQ->prioList[i]);
+
+	os_heap_free(msgQ->prioList);
+	msgQ->prioList = NULL;
+}
+
 /**********************************************
  * PUBLIC FUNCTIONS
  *********************************************/
@@ -64,7 +83,7 @@ static os_err_e os_msgQ_objTake(os_handle_t h, os_handle_t takingTask){
  * @brief This function creates a message queue
  *
  * @param os_handle_t* msgQ 	: [out] handle to msgQ
- * @param os_msgQ_mode_e mode 	: [ in] The queue's mode: FIFO or LIFO
+ * @param os_msgQ_mode_e mode 	: [ in] The queue's mode: FIFO, LIFO or PRIO (highest message priority first, FIFO among equal priorities)
  * @param char* name			: [ in] messqge Q name. If a queue with the same name already exists, its reference is returned. A null name always creates a nameless queue.
  *
  * @return os_err_e OS_ERR_OK if OK
@@ -102,18 +121,28 @@ os_err_e os_msgQ_create(os_handle_t* msgQ, os_msgQ_mode_e mode, char const * nam
 	q->obj.getFreeCount		= os_msgQ_getFreeCount;
 	q->obj.obj_take 		= os_msgQ_objTake;
 	q->obj.blockList		= os_list_init();
+	q->obj.waitSet			= NULL;
 	q->obj.name				= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
 
 	/* Finish init
 	 ------------------------------------------------------*/
-	q->msgList		 		= os_list_init();
+	q->msgList		 		= mode == OS_MSGQ_MODE_PRIO ? NULL : os_list_init();
 	q->mode		 			= mode;
+	q->prioList				= mode == OS_MSGQ_MODE_PRIO ? (void**)os_heap_alloc(OS_MSGQ_PRIO_LEVELS * sizeof(void*)) : NULL;
+	q->prioBitmap			= 0;
+	q->prioMsgCount			= 0;
+
+	/* Priority lists are only created when a message with that priority is pushed
+	 ------------------------------------------------------*/
+	if(q->prioList != NULL)
+		memset(q->prioList, 0, OS_MSGQ_PRIO_LEVELS * sizeof(void*));
 
 	/* Handles heap errors
 	 ------------------------------------------------------*/
-	if(q->obj.blockList == NULL || q->msgList == NULL || (q->obj.name == NULL && name != NULL) ){
+	if(q->obj.blockList == NULL || (q->msgList == NULL && q->prioList == NULL) || (q->obj.name == NULL && name != NULL) ){
 		os_list_clear(q->obj.blockList);
 		os_list_clear(q->msgList);
+		os_heap_free(q->prioList);
 		os_heap_free(q->obj.name);
 		os_heap_free(q);
 
@@ -131,6 +160,7 @@ os_err_e os_msgQ_create(os_handle_t* msgQ, os_msgQ_mode_e mode, char const * nam
 	if(ret != OS_ERR_OK) {
 		os_list_clear(q->obj.blockList);
 		os_list_clear(q->msgList);
+		os_heap_free(q->prioList);
 		os_heap_free(q->obj.name);
 		os_heap_free(q);
 
@@ -155,16 +185,55 @@ os_err_e os_msgQ_create(os_handle_t* msgQ, os_msgQ_mode_e mode, char const * nam
  * @return os_err_e OS_ERR_OK if OK
  **********************************************************************/
 os_err_e os_msgQ_push(os_handle_t h, void* msg){
+	return os_msgQ_push_prio(h, msg, 0);
+}
+
+
+/***********************************************************************
+ * OS MsgQ Push with priority
+ *
+ * @brief This function pushes a message with a given priority. The priority is ignored if the queue is not in PRIO mode
+ *
+ * @param os_handle_t h : [ in] Handle to the queue
+ * @param void* msg     : [ in] Reference to the message
+ * @param uint8_t prio  : [ in] Message priority, from 0 (lowest) to OS_MSGQ_PRIO_LEVELS - 1 (highest)
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_msgQ_push_prio(os_handle_t h, void* msg, uint8_t prio){
 
 	/* Check arguments
 	 ------------------------------------------------------*/
 	os_msgQ_t* msgQ = (os_msgQ_t*)h;
 	if(msgQ == NULL) return OS_ERR_BAD_ARG;
 	if(msgQ->obj.type != OS_OBJ_MSGQ) return OS_ERR_BAD_ARG;
+	if(msgQ->mode == OS_MSGQ_MODE_PRIO && prio >= OS_MSGQ_PRIO_LEVELS) return OS_ERR_BAD_ARG;
 
 	/* add message on list
 	 ------------------------------------------------------*/
-	os_err_e ret = os_list_add(((os_list_head_t*)msgQ->msgList), msg, msgQ->mode == OS_MSGQ_MODE_FIFO ? OS_LIST_FIRST : OS_LIST_LAST);
+	os_err_e ret = OS_ERR_OK;
+	if(msgQ->mode != OS_MSGQ_MODE_PRIO){
+		ret = os_list_add(((os_list_head_t*)msgQ->msgList), msg, msgQ->mode == OS_MSGQ_MODE_FIFO ? OS_LIST_FIRST : OS_LIST_LAST);
+	}
+
+	/* add message at the end of its priority list and flag the priority as used
+	 ------------------------------------------------------*/
+	else{
+		OS_DECLARE_IRQ_STATE;
+		OS_ENTER_CRITICAL();
+
+		if(msgQ->prioList[prio] == NULL)
+			msgQ->prioList[prio] = os_list_init();
+
+		ret = msgQ->prioList[prio] == NULL ? OS_ERR_INSUFFICIENT_HEAP : os_list_add(msgQ->prioList[prio], msg, OS_LIST_LAST);
+		if(ret == OS_ERR_OK){
+			msgQ->prioBitmap |= (1UL << prio);
+			msgQ->prioMsgCount++;
+		}
+
+		OS_EXIT_CRITICAL();
+	}
+
 	if(ret != OS_ERR_OK)
 		return ret;
 
@@ -199,7 +268,7 @@ void* os_msgQ_pop(os_handle_t h, os_err_e* err){
 
 	/* Check if queue is empty
     ------------------------------------------------------*/
-    if(((os_list_head_t*)msgQ->msgList)->listSize == 0) {
+    if(os_msgQ_getNumberOfMsgs(h) == 0) {
         if(err != NULL) 
             *err = OS_ERR_EMPTY;
             
@@ -208,7 +277,39 @@ void* os_msgQ_pop(os_handle_t h, os_err_e* err){
 
 	/* remove message from list
 	 ------------------------------------------------------*/
-	void* ret = os_list_pop(((os_list_head_t*)msgQ->msgList), OS_LIST_FIRST, err);
+	void* ret = NULL;
+	if(msgQ->mode != OS_MSGQ_MODE_PRIO){
+		ret = os_list_pop(((os_list_head_t*)msgQ->msgList), OS_LIST_FIRST, err);
+	}
+
+	/* The highest set bit of the bitmap is the highest priority with pending messages
+	 ------------------------------------------------------*/
+	else{
+		OS_DECLARE_IRQ_STATE;
+		OS_ENTER_CRITICAL();
+
+		/* Another consumer may have emptied the queue since the check above
+		 ------------------------------------------------------*/
+		if(msgQ->prioBitmap == 0){
+			OS_EXIT_CRITICAL();
+
+			if(err != NULL)
+				*err = OS_ERR_EMPTY;
+
+			return NULL;
+		}
+
+		uint32_t prio = 31 - __builtin_clz(msgQ->prioBitmap);
+		os_list_head_t* list = (os_list_head_t*)msgQ->prioList[prio];
+
+		ret = os_list_pop(list, OS_LIST_FIRST, err);
+		msgQ->prioMsgCount--;
+
+		if(list->listSize == 0)
+			msgQ->prioBitmap &= ~(1UL << prio);
+
+		OS_EXIT_CRITICAL();
+	}
 
 	/* Update block list
 	 ------------------------------------------------------*/
@@ -239,17 +340,19 @@ os_err_e os_msgQ_delete(os_handle_t h){
 	if(msgQ == NULL) return OS_ERR_BAD_ARG;
 	if(msgQ->obj.type != OS_OBJ_MSGQ) return OS_ERR_BAD_ARG;
 
-	/* Deletes from obj list
+	/* Deletes from obj list and from its wait-set
 	 ------------------------------------------------------*/
 	os_list_remove(&os_obj_head, msgQ);
+	os_waitset_detach((os_handle_t)msgQ);
 
 	/* Free block list
 	 ------------------------------------------------------*/
 	os_list_clear(msgQ->obj.blockList);
 
-	/* Free msg list
+	/* Free msg lists
 	 ------------------------------------------------------*/
 	os_list_clear(msgQ->msgList);
+	os_msgQ_clearPrioLists(msgQ);
 	os_heap_free(msgQ->obj.name);
 
 	return os_heap_free(msgQ);
@@ -275,5 +378,8 @@ uint32_t os_msgQ_getNumberOfMsgs(os_handle_t h){
 
 	/* return number of messages
 	 ------------------------------------------------------*/
+	if(msgQ->mode == OS_MSGQ_MODE_PRIO)
+		return msgQ->prioMsgCount;
+
 	return ((os_list_head_t*)msgQ->msgList)->listSize;
 }
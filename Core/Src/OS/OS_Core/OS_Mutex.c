@@ -70,6 +70,10 @@ static os_err_e os_mutex_objTake(os_handle_t h, os_handle_t takingTask){
 	if(takingTask == NULL) return OS_ERR_BAD_ARG;
 	if(takingTask->type != OS_OBJ_TASK) return OS_ERR_BAD_ARG;
 
+	/* A task above the ceiling would break the protocol
+	 ------------------------------------------------------*/
+	if(mutex->ceiling >= 0 && t->basePriority > mutex->ceiling) return OS_ERR_FORBIDDEN;
+
 	/* Store owner task
 	 ------------------------------------------------------*/
 	mutex->owner = takingTask;
@@ -80,26 +84,25 @@ static os_err_e os_mutex_objTake(os_handle_t h, os_handle_t takingTask){
 
 	/* Add mutex to the owned mutex list
 	 ------------------------------------------------------*/
-	return os_list_add(t->ownedMutex, h, OS_LIST_FIRST);
-}
+	os_err_e ret = os_list_add(t->ownedMutex, h, OS_LIST_FIRST);
+	mutex->ownerListed = ret == OS_ERR_OK;
 
-
-/**********************************************
- * PUBLIC FUNCTIONS
- *********************************************/
+	return ret;
+}
 
 
 /***********************************************************************
- * OS Mutex Create
+ * OS Mutex Alloc
  *
- * @brief This function creates a mutex
+ * @brief This function allocates and registers a mutex
  *
- * @param os_handle_t* h 		: [out] handle to semaphore
- * @param char* name			: [ in] Mutex's name. If a mutex with the same name already exists, its reference is returned. A null name always creates a nameless mutex.
+ * @param os_handle_t* h 		: [out] handle to mutex
+ * @param int8_t ceiling		: [ in] Priority ceiling, -1 to use priority inheritance
+ * @param char* name			: [ in] Mutex's name. If a mutex with the same name already exists, its reference is returned.
  *
  * @return os_err_e OS_ERR_OK if OK
  **********************************************************************/
-os_err_e os_mutex_create(os_handle_t* h, char const * name){
+static os_err_e os_mutex_alloc(os_handle_t* h, int8_t ceiling, char const * name){
 
 	/* Check for argument errors
 	 ------------------------------------------------------*/
@@ -131,13 +134,16 @@ os_err_e os_mutex_create(os_handle_t* h, char const * name){
 	mutex->obj.getFreeCount		= os_mutex_getFreeCount;
 	mutex->obj.obj_take			= os_mutex_objTake;
 	mutex->obj.blockList		= os_list_init();
+	mutex->obj.waitSet			= NULL;
 	mutex->obj.name			    = name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
 
 	/* Finish init
 	 ------------------------------------------------------*/
 	mutex->state 				= OS_MUTEX_STATE_UNLOCKED;
 	mutex->owner 				= NULL;
-	mutex->max_prio 			= -1;
+	mutex->max_prio 			= ceiling;
+	mutex->ownerListed 			= false;
+	mutex->ceiling 				= ceiling;
 
 	/* Handles heap errors
 	 ------------------------------------------------------*/
@@ -170,6 +176,90 @@ os_err_e os_mutex_create(os_handle_t* h, char const * name){
 }
 
 
+/**********************************************
+ * OS PRIVATE FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Mutex fast take
+ *
+ * @brief This function takes a free mutex nobody is waiting for without going through the generic wait.
+ * The mutex is not added to the owner's owned list: os_mutex_udpatePrio does it if a task ever blocks on it.
+ *
+ * @param os_handle_t h : [in] mutex to take
+ *
+ * @return bool : 1 = mutex taken; 0 = the slow path must be used
+ **********************************************************************/
+bool os_mutex_fastTake(os_handle_t h){
+
+	/* Cannot take a mutex in interrupt mode, let the slow path report it
+	 ------------------------------------------------------*/
+	uint32_t ipsr;
+	__asm volatile("mrs %[out], ipsr" : [out] "=r" (ipsr));
+	if(ipsr != 0) return false;
+
+	os_mutex_t* mutex = (os_mutex_t*)h;
+	bool taken = false;
+
+	/* Only take it if free, uncontended and not watched by a wait-set.
+	 * Ceiling mutexes must raise their owner right away, so they always take the slow path
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		if(mutex->state == OS_MUTEX_STATE_UNLOCKED && mutex->ceiling < 0 && ((os_list_head_t*)h->blockList)->listSize == 0 && h->waitSet == NULL){
+			mutex->owner 		= (os_handle_t)os_cur_task->element;
+			mutex->state 		= OS_MUTEX_STATE_LOCKED;
+			mutex->ownerListed 	= false;
+			taken 				= true;
+		}
+	);
+
+	return taken;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Mutex Create
+ *
+ * @brief This function creates a mutex
+ *
+ * @param os_handle_t* h 		: [out] handle to semaphore
+ * @param char* name			: [ in] Mutex's name. If a mutex with the same name already exists, its reference is returned. A null name always creates a nameless mutex.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mutex_create(os_handle_t* h, char const * name){
+	return os_mutex_alloc(h, -1, name);
+}
+
+
+/***********************************************************************
+ * OS Mutex Create Ceiling
+ *
+ * @brief This function creates a mutex using the immediate priority ceiling protocol.
+ * The owner runs at least at the ceiling priority while it holds the mutex, and waiters never lend their priority.
+ * The ceiling must be at least the priority of every task using the mutex.
+ *
+ * @param os_handle_t* h 		: [out] handle to mutex
+ * @param int8_t ceiling_prio	: [ in] Ceiling priority (0 to 127)
+ * @param char* name			: [ in] Mutex's name. If a mutex with the same name already exists, its reference is returned. A null name always creates a nameless mutex.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_mutex_create_ceiling(os_handle_t* h, int8_t ceiling_prio, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(ceiling_prio < 0) 			return OS_ERR_BAD_ARG;
+
+	return os_mutex_alloc(h, ceiling_prio, name);
+}
+
+
 /***********************************************************************
  * OS Mutex Release
  *
@@ -192,13 +282,29 @@ os_err_e os_mutex_release(os_handle_t h){
 	if(mutex->state == OS_MUTEX_STATE_UNLOCKED) return OS_ERR_FORBIDDEN;
 	if(mutex->owner != os_cur_task->element) return OS_ERR_FORBIDDEN;
 
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Fast path: nobody is waiting, so nobody lent its priority and nobody must wake up
+	 ------------------------------------------------------*/
+	if(mutex->ownerListed == false && ((os_list_head_t*)h->blockList)->listSize == 0 && h->waitSet == NULL){
+		mutex->state = OS_MUTEX_STATE_UNLOCKED;
+		OS_EXIT_CRITICAL();
+		return OS_ERR_OK;
+	}
+
+	OS_EXIT_CRITICAL();
+
 	/* Enter critical section
 	 ------------------------------------------------------*/
 	OS_CRITICAL_SECTION(
 
 		/* Remove mutex from owned mutex list
 		 ------------------------------------------------------*/
-		os_list_remove( ((os_task_t*)mutex->owner)->ownedMutex, h);
+		if(mutex->ownerListed) os_list_remove( ((os_task_t*)mutex->owner)->ownedMutex, h);
+		mutex->ownerListed = false;
 
 		/* Update priority of the owner
 		 ------------------------------------------------------*/
@@ -239,9 +345,10 @@ os_err_e os_mutex_delete(os_handle_t h){
 	if(h == NULL) return OS_ERR_BAD_ARG;
 	if(h->type != OS_OBJ_MUTEX) return OS_ERR_BAD_ARG;
 
-	/* Deletes from obj list
+	/* Deletes from obj list and from its wait-set
 	 ------------------------------------------------------*/
 	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
 
 	/* Free memory
 	 ------------------------------------------------------*/
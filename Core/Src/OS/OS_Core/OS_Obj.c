@@ -40,6 +40,7 @@ os_list_head_t os_obj_head;	//Head to obj list
  * OS_OBJ_MUTEX : The mutex is free
  * OS_OBJ_EVT   : The event is set
  * OS_OBJ_MSGQ  : There is at least one message in the queue
+ * OS_OBJ_RWLOCK: The lock can be taken with the access mode of the task
  *
  * @param os_handle_t objList[]  : [ in] Array containing all objects to wait
  * @param size_t objNum			 : [ in] number of objects to wait
@@ -68,6 +69,18 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 		return NULL;
 	}
 
+	/* A task above the ceiling of a mutex could never take it, reject it before it blocks
+	 ---------------------------------------------------*/
+	for(size_t i = 0; i < objNum; i++){
+		if(objList[i]->type != OS_OBJ_MUTEX) continue;
+
+		int8_t ceiling = ((os_mutex_t*)objList[i])->ceiling;
+		if(ceiling >= 0 && ((os_task_t*)os_cur_task->element)->basePriority > ceiling){
+			if(err != NULL) *err = OS_ERR_FORBIDDEN;
+			return NULL;
+		}
+	}
+
 	/* Enter critical to access possible shared resource
 	 ---------------------------------------------------*/
 	bool blocked = false;
@@ -118,7 +131,7 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 
 				/* Check if we are in thread mode (cannot take a mutex in interupt mode)
 				 ---------------------------------------------------*/
-				if( (xPSR & 0x1F) != 0 && objList[i]->type == OS_OBJ_MUTEX) {
+				if( (xPSR & 0x1F) != 0 && (objList[i]->type == OS_OBJ_MUTEX || objList[i]->type == OS_OBJ_RWLOCK) ) {
 					if(err != NULL) *err = OS_ERR_FORBIDDEN;
 					OS_EXIT_CRITICAL();
 					return NULL;
@@ -140,6 +153,19 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 						}
 					}
 
+					/* If task blocked, remove from the lists it is still in
+					 ---------------------------------------------------*/
+					if(blocked) {
+						for(size_t j = i; j < objNum; j++){
+							os_list_remove(objList[j]->blockList, (os_handle_t)os_cur_task->element);
+							os_obj_updatePrio(objList[j]);
+						}
+
+						for(size_t j = 0; j < objNum; j++){
+							os_handle_list_updateAndCheck(objList[j]);
+						}
+					}
+
 					OS_EXIT_CRITICAL();
 					if(err != NULL) *err = retErr;
 					return NULL;
@@ -182,7 +208,7 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 
 			/* Check if we are in thread mode (cannot take a mutex in interupt mode)
 			 ---------------------------------------------------*/
-			if( (xPSR & 0x1F) != 0 && objList[takingPos]->type == OS_OBJ_MUTEX) {
+			if( (xPSR & 0x1F) != 0 && (objList[takingPos]->type == OS_OBJ_MUTEX || objList[takingPos]->type == OS_OBJ_RWLOCK) ) {
 				if(err != NULL) *err = OS_ERR_FORBIDDEN;
 				OS_EXIT_CRITICAL();
 				return NULL;
@@ -192,6 +218,20 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 			 ---------------------------------------------------*/
 			os_err_e retErr = (objList[takingPos]->obj_take != NULL) ? objList[takingPos]->obj_take(objList[takingPos], os_cur_task->element) : OS_ERR_UNKNOWN;
 			if(retErr != OS_ERR_OK){
+
+				/* If task blocked, remove from everyone's list
+				 ---------------------------------------------------*/
+				if(blocked) {
+					for(size_t i = 0; i < objNum; i++){
+						os_list_remove(objList[i]->blockList, (os_handle_t)os_cur_task->element);
+						os_obj_updatePrio(objList[i]);
+					}
+
+					for(size_t i = 0; i < objNum; i++){
+						os_handle_list_updateAndCheck(objList[i]);
+					}
+				}
+
 				OS_EXIT_CRITICAL();
 				if(err != NULL) *err = retErr;
 				return NULL;
@@ -254,9 +294,9 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 			return NULL;
 		}
 
-		/* Task cannot block of scheduler is not running
+		/* Task cannot block of scheduler is not running or locked
 		 ---------------------------------------------------*/
-		if(os_scheduler_state_get() != OS_SCHEDULER_START) {
+		if(os_scheduler_state_get() != OS_SCHEDULER_START || os_scheduler_isLocked()) {
 
 			/* If task blocked, remove from everyone's list
 			 ---------------------------------------------------*/
@@ -273,7 +313,7 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
 				}
 			}
 
-			if(err != NULL) *err = OS_ERR_NOT_READY;
+			if(err != NULL) *err = os_scheduler_state_get() != OS_SCHEDULER_START ? OS_ERR_NOT_READY : OS_ERR_FORBIDDEN;
 			OS_EXIT_CRITICAL();
 			return NULL;
 		}
@@ -417,6 +457,13 @@ static os_handle_t os_obj_wait(os_handle_t objList[], size_t objNum, os_obj_wait
  **********************************************************************/
 os_handle_t os_obj_single_wait(os_handle_t obj, uint32_t timeout_ticks, os_err_e* err){
 
+	/* Uncontended mutexes and semaphores do not need the generic wait
+	 ---------------------------------------------------*/
+	if(obj != NULL && ( (obj->type == OS_OBJ_MUTEX && os_mutex_fastTake(obj)) || (obj->type == OS_OBJ_SEM && os_sem_fastTake(obj)) )){
+		if(err != NULL) *err = OS_ERR_OK;
+		return obj;
+	}
+
 	/* Form array and call wait function
 	 ---------------------------------------------------*/
 	os_handle_t objList[] = { obj };
@@ -10,19 +10,613 @@
 #include "OS/OS_Core/OS_Internal.h"
 #include "OS/OS_Core/OS_Process.h"
 
+/**********************************************
+ * PRIVATE TYPES
+ *********************************************/
+
+/* Location of a LOAD segment once loaded
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	vaddr;			//Virtual address of the segment
+	uint32_t	memsz;			//Size of the segment in memory
+	uint8_t*	host;			//Address of the segment in RAM or in the installed image area
+	bool		readOnly;		//Segment shared with other processes (installed or cached text), it cannot be patched
+} os_elf_map_t;
+
+/* Text shared in RAM by the processes running the same program
+ ---------------------------------------------------*/
+typedef struct{
+	char*		name;			//Name of the ELF file
+	uint32_t	key;			//Build of the ELF file (see os_elf_buildKey)
+	uint32_t	size;			//Size of the text
+	uint32_t	refs;			//Number of processes using the text
+	uint8_t*	data;			//The text
+} os_elf_text_t;
+
+/* Launch parameters of a process : defaults, overridden by the manifest of the program
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	stackSize;		//Stack size of the main thread
+	uint32_t	heapSize;		//Room left in the arena for os_heap_alloc
+	uint32_t	argsSize;		//Room taken by the arguments in the arena (see os_process_argsSize)
+	int8_t		priority;		//Priority of the main thread
+} os_process_params_t;
+
+/* ELF loader context. Tables read in bulk, freed once the process is loaded
+ ---------------------------------------------------*/
+typedef struct{
+	uint8_t*		ph;							//Program header table
+	uint8_t*		sh;							//Section header table
+	char*			shstr;						//Section names (.shstrtab), null terminated
+	uint32_t		shstrSize;					//Size of the section names
+	os_elf_map_t	map[OS_ELF_MAP_MAX];		//Loaded segments
+	uint32_t		mapNum;						//Number of loaded segments
+} os_elf_ctx_t;
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_cell_t* os_cur_task;			//Current task pointer
+extern os_handle_t fsMutex;					//FS mutex (lfs is not thread safe)
+
 /**********************************************
  * PUBLIC VARIABLES
  *********************************************/
 
 os_list_head_t os_process_list;				//Head of process list
 
+/**********************************************
+ * PRIVATE VARIABLES
+ *********************************************/
+
+static os_list_head_t os_text_list;			//Texts shared in RAM (os_elf_text_t)
+static uint32_t os_process_windowTicks;		//Ticks elapsed in the current CPU accounting window
+static os_handle_t os_process_loaderWorkQ;	//Work queue running the asynchronous loads
+
 /**********************************************
  * OS PRIVATE FUNCTIONS
  *********************************************/
 
+//////////////////////////////////////////////// PROCESS MEMORY //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Process arena create
+ *
+ * @brief This function creates the arena of a process and allocates its image in it. Everything else the process allocates
+ * (main stack, arguments, os_heap_alloc calls) must fit in the reserve
+ *
+ * @param os_process_t* p 		: [in] Process reference
+ * @param uint32_t imageSize 	: [in] Size of the image (0 if the whole program is executed in place)
+ * @param uint32_t reserve 		: [in] Size of the arena left once the image is allocated
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_process_arenaCreate(os_process_t* p, uint32_t imageSize, uint32_t reserve){
+
+	uint32_t imageBlock = imageSize == 0 ? 0 : ((imageSize + 7) & (~0x7UL)) + OS_HEAP_BLOCK_HEADER_SIZE;
+
+	p->arena = os_heap_arenaCreate(imageBlock + reserve);
+	if(p->arena == NULL)
+		return OS_ERR_INSUFFICIENT_HEAP;
+
+	if(imageSize == 0)
+		return OS_ERR_OK;
+
+	p->segments = (uint8_t*) os_heap_arenaAlloc(p->arena, imageSize);
+	if(p->segments == NULL)
+		return OS_ERR_INSUFFICIENT_HEAP;
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Process arena alloc
+ *
+ * @brief This function allocates memory in the arena of a process and charges it to its heap usage
+ *
+ * @param os_process_t* p 	: [in] Process reference
+ * @param uint32_t size 	: [in] Size to be allocated
+ *
+ * @return void* : Address of the memory block or NULL if the arena is full
+ **********************************************************************/
+static void* os_process_arenaAlloc(os_process_t* p, uint32_t size){
+
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	void* ptr = os_heap_arenaAlloc(p->arena, size);
+	p->usage.heapBytes += os_heap_arenaBlockSize(p->arena, ptr);
+
+	OS_EXIT_CRITICAL();
+	return ptr;
+}
+
+
+/***********************************************************************
+ * OS Process arguments size
+ *
+ * @brief This function computes the room the arguments take in the arena
+ *
+ * @param int argc 		: [in] Argument number
+ * @param char* argv[] 	: [in] Arguments
+ *
+ * @return uint32_t : the size, block headers included
+ **********************************************************************/
+static uint32_t os_process_argsSize(int argc, char* argv[]){
+
+	if(argc <= 0 || argv == NULL)
+		return 0;
+
+	uint32_t size = (((uint32_t)argc * sizeof(char*) + 7) & (~0x7UL)) + OS_HEAP_BLOCK_HEADER_SIZE;
+	for(int i = 0; i < argc; i++)
+		size += ((strlen(argv[i]) + 1 + 7) & (~0x7UL)) + OS_HEAP_BLOCK_HEADER_SIZE;
+
+	return size;
+}
+
+
+/***********************************************************************
+ * OS Process apply manifest
+ *
+ * @brief This function overrides the launch parameters with the ones requested by the manifest of the program
+ *
+ * @param os_process_params_t* params 	: [in] Launch parameters, [out] Launch parameters requested by the program
+ * @param os_manifest_t const* m 		: [in] Manifest of the program
+ *
+ * @return os_err_e : OS_ERR_INVALID if the manifest is corrupted or the program was built for another kernel ABI
+ **********************************************************************/
+static os_err_e os_process_applyManifest(os_process_params_t* params, os_manifest_t const* m){
+
+	/* Check the manifest
+	 ------------------------------------------------------*/
+	if(m->magic != OS_MANIFEST_MAGIC || m->stackSize > OS_HEAP_SIZE || m->heapSize > OS_HEAP_SIZE)
+		return OS_ERR_INVALID;
+
+	if(m->abiVersion != 0 && m->abiVersion != OS_ABI_VERSION){
+		PRINTLN("Program built for kernel ABI %lu, kernel ABI is %d", m->abiVersion, OS_ABI_VERSION);
+		return OS_ERR_INVALID;
+	}
+
+	/* Take the parameters requested
+	 ------------------------------------------------------*/
+	if(m->stackSize != 0)
+		params->stackSize = m->stackSize < OS_MINIMUM_STACK_SIZE ? OS_MINIMUM_STACK_SIZE : (m->stackSize + 7) & (~0x7UL);
+
+	if(m->heapSize != 0)
+		params->heapSize = m->heapSize;
+
+	if(m->priority > 0)
+		params->priority = m->priority > OS_PROCESS_MAX_PRIO ? OS_PROCESS_MAX_PRIO : m->priority;
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Process reserve
+ *
+ * @brief This function computes the room the process needs in its arena besides its image
+ *
+ * @param os_process_params_t const* params : [in] Launch parameters
+ *
+ * @return uint32_t : the size, block headers included
+ **********************************************************************/
+static inline uint32_t os_process_reserve(os_process_params_t const* params){
+	return params->stackSize + OS_HEAP_BLOCK_HEADER_SIZE + params->argsSize + params->heapSize;
+}
+
+
+/***********************************************************************
+ * OS Process arguments copy
+ *
+ * @brief This function copies the arguments to the arena of the process
+ *
+ * @param os_process_t* p 	: [in] Process reference
+ * @param int argc 			: [in] Argument number
+ * @param char* argv[] 		: [in] Arguments
+ *
+ * @return char** : the copy, NULL if error
+ **********************************************************************/
+static char** os_process_argsCopy(os_process_t* p, int argc, char* argv[]){
+
+	char** copy = (char**) os_process_arenaAlloc(p, (uint32_t)argc * sizeof(char*));
+	if(copy == NULL)
+		return NULL;
+
+	for(int i = 0; i < argc; i++){
+		copy[i] = (char*) os_process_arenaAlloc(p, strlen(argv[i]) + 1);
+		if(copy[i] == NULL)
+			return NULL;
+
+		strcpy(copy[i], argv[i]);
+	}
+
+	return copy;
+}
+
+
+/***********************************************************************
+ * OS Process heap alloc
+ *
+ * @brief This function allocates memory for the calling process, in its arena. Processes link os_heap_alloc to it.
+ * Kernel tasks get memory from the global heap
+ *
+ * @param uint32_t size : [in] Size to be allocated
+ *
+ * @return void* : Address of the memory block or NULL if the function failed (bad argument, arena full or heap quota reached)
+ **********************************************************************/
+void* os_process_heapAlloc(uint32_t size){
+
+	os_process_t* p = ((os_task_t*)os_cur_task->element)->process;
+
+	if(p == NULL || p->arena == NULL)
+		return os_heap_alloc(size);
+
+	/* Check the quota with the smallest block that can hold the data
+	 ------------------------------------------------------*/
+	uint32_t block = ((size + 7) & (~0x7UL)) + OS_HEAP_BLOCK_HEADER_SIZE;
+	if(p->limits.heapQuota != 0 && p->usage.heapBytes + block > p->limits.heapQuota)
+		return NULL;
+
+	return os_process_arenaAlloc(p, size);
+}
+
+
+/***********************************************************************
+ * OS Process heap free
+ *
+ * @brief This function frees memory allocated by os_process_heapAlloc and deducts it from the usage of the calling process.
+ * Processes link os_heap_free to it
+ *
+ * @param void* ptr : [in] Address of the memory block
+ *
+ * @return os_err_e : An error code (0 = OK)
+ **********************************************************************/
+os_err_e os_process_heapFree(void* ptr){
+
+	os_process_t* p = ((os_task_t*)os_cur_task->element)->process;
+
+	if(p == NULL || p->arena == NULL)
+		return os_heap_free(ptr);
+
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	uint32_t size = os_heap_arenaBlockSize(p->arena, ptr);
+	os_err_e ret = os_heap_free(ptr);
+	if(ret == OS_ERR_OK)
+		p->usage.heapBytes = p->usage.heapBytes > size ? p->usage.heapBytes - size : 0;
+
+	OS_EXIT_CRITICAL();
+	return ret;
+}
+
+
+//////////////////////////////////////////////// PROCESS ACCOUNTING //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Process throttle
+ *
+ * @brief This function demotes the threads of a process to OS_PROCESS_THROTTLE_PRIO (see os_task_udpatePrio), or gives them
+ * their priority back. Must be called with interrupts disabled
+ *
+ * @param os_process_t* p 	: [in] Process reference
+ * @param bool throttled 	: [in] true to demote the process
+ **********************************************************************/
+static void os_process_throttle(os_process_t* p, bool throttled){
+
+	p->usage.throttled = throttled;
+
+	for(os_list_cell_t* it = ((os_list_head_t*)p->thread_list)->head.next; it != NULL; it = it->next)
+		os_obj_updatePrio((os_handle_t)it->element);
+}
+
+
+/***********************************************************************
+ * OS Process Tick
+ *
+ * @brief This function charges the tick to the process of the running task, throttles the processes exceeding their CPU share
+ * and closes the accounting window when it elapsed. Must be called with interrupts disabled
+ *
+ * @param uint32_t ms_inc : [in] Amount of ms elapsed
+ **********************************************************************/
+void os_process_tick(uint32_t ms_inc){
+
+	/* Charge the process running when the tick happened
+	 ------------------------------------------------------*/
+	os_process_t* p = os_cur_task == NULL ? NULL : ((os_task_t*)os_cur_task->element)->process;
+	if(p != NULL){
+		p->usage.cpuTicks += ms_inc;
+		p->usage.cpuWindow += ms_inc;
+
+		if(!p->usage.throttled && p->limits.cpuShare < 100 && p->usage.cpuWindow * 100 >= (uint32_t)p->limits.cpuShare * OS_PROCESS_CPU_WINDOW_MS)
+			os_process_throttle(p, true);
+	}
+
+	/* Close the window : publish the load of each process and lift the throttling
+	 ------------------------------------------------------*/
+	os_process_windowTicks += ms_inc;
+	if(os_process_windowTicks < OS_PROCESS_CPU_WINDOW_MS)
+		return;
+
+	for(os_list_cell_t* it = os_process_list.head.next; it != NULL; it = it->next){
+		p = (os_process_t*)it->element;
+
+		p->usage.cpuLoad = (uint8_t)( p->usage.cpuWindow >= os_process_windowTicks ? 100 : p->usage.cpuWindow * 100 / os_process_windowTicks );
+		p->usage.cpuWindow = 0;
+
+		if(p->usage.throttled)
+			os_process_throttle(p, false);
+	}
+
+	os_process_windowTicks = 0;
+}
+
+
 //////////////////////////////////////////////// ELF LOADER //////////////////////////////////////////////////
 
 
+/***********************************************************************
+ * OS ELF segment
+ *
+ * @brief This function gets a program header from the table loaded by os_elf_loadTables
+ *
+ * @return os_elf_programHeader_t* : the program header
+ **********************************************************************/
+static inline os_elf_programHeader_t* os_elf_segment(os_process_t* p, os_elf_ctx_t* ctx, uint32_t index){
+	return (os_elf_programHeader_t*)&ctx->ph[index * p->elf_H.e_phentsize];
+}
+
+
+/***********************************************************************
+ * OS ELF section
+ *
+ * @brief This function gets a section header from the table loaded by os_elf_loadTables
+ *
+ * @return os_elf_sectionHeader_t* : the section header
+ **********************************************************************/
+static inline os_elf_sectionHeader_t* os_elf_section(os_process_t* p, os_elf_ctx_t* ctx, uint32_t index){
+	return (os_elf_sectionHeader_t*)&ctx->sh[index * p->elf_H.e_shentsize];
+}
+
+
+/***********************************************************************
+ * OS ELF map
+ *
+ * @brief This function translates a block of the program to where it was loaded
+ *
+ * @param os_elf_ctx_t* ctx 	: [in] Loaded segments
+ * @param uint32_t vaddr 		: [in] Virtual address of the block
+ * @param uint32_t size 		: [in] Size of the block
+ * @param bool write 			: [in] The block is going to be patched
+ *
+ * @return uint8_t* : the block, NULL if it is not fully inside a segment or if it must be patched and is shared
+ **********************************************************************/
+static uint8_t* os_elf_map(os_elf_ctx_t* ctx, uint32_t vaddr, uint32_t size, bool write){
+
+	for(uint32_t i = 0; i < ctx->mapNum; i++){
+		os_elf_map_t* m = &ctx->map[i];
+
+		if(vaddr < m->vaddr || vaddr - m->vaddr > m->memsz || size > m->memsz - (vaddr - m->vaddr))
+			continue;
+
+		if(write && m->readOnly)
+			return NULL;
+
+		return &m->host[vaddr - m->vaddr];
+	}
+
+	return NULL;
+}
+
+
+/***********************************************************************
+ * OS ELF rebase
+ *
+ * @brief This function computes the run time address of a program address. An address ending a segment stays attached to it,
+ * addresses out of every segment are moved with the first one
+ *
+ * @param os_elf_ctx_t* ctx 	: [in] Loaded segments
+ * @param uint32_t vaddr 		: [in] Virtual address
+ *
+ * @return uint32_t : the run time address
+ **********************************************************************/
+static uint32_t os_elf_rebase(os_elf_ctx_t* ctx, uint32_t vaddr){
+
+	uint8_t* host = os_elf_map(ctx, vaddr, 1, false);
+	if(host == NULL)
+		host = os_elf_map(ctx, vaddr, 0, false);
+
+	if(host != NULL || ctx->mapNum == 0)
+		return (uint32_t)host;
+
+	return (uint32_t)ctx->map[0].host - ctx->map[0].vaddr + vaddr;
+}
+
+
+/***********************************************************************
+ * OS ELF text segment
+ *
+ * @brief This function searches the segment that can be executed in place: the only LOAD segment that is not writable
+ *
+ * @param os_process_t* p 		: [in] Process reference
+ * @param os_elf_ctx_t* ctx 	: [in] Tables of the elf file
+ *
+ * @return os_elf_programHeader_t* : the segment, NULL if the program has none or several of them
+ **********************************************************************/
+static os_elf_programHeader_t* os_elf_textSegment(os_process_t* p, os_elf_ctx_t* ctx){
+
+	os_elf_programHeader_t* text = NULL;
+
+	for(uint32_t i = 0; i < p->elf_H.e_phnum; i++){
+		os_elf_programHeader_t* data = os_elf_segment(p, ctx, i);
+
+		if(data->p_type != OS_ELF_PT_LOAD || (data->p_flags & OS_ELF_PF_W) != 0)
+			continue;
+
+		if(text != NULL)
+			return NULL;
+
+		text = data;
+	}
+
+	/* The text is copied as is, it must not contain zero filled memory
+	 ------------------------------------------------------*/
+	if(text == NULL || text->p_filesz != text->p_memsz || text->p_memsz == 0)
+		return NULL;
+
+	return text;
+}
+
+
+/***********************************************************************
+ * OS ELF key
+ *
+ * @brief This function computes the part of the key of a program that comes from its ELF header and program header table
+ *
+ * @return uint32_t : the key
+ **********************************************************************/
+static inline uint32_t os_elf_key(os_process_t* p, os_elf_ctx_t* ctx){
+	return os_xip_key(&p->elf_H, sizeof(p->elf_H), ctx->ph, (size_t)p->elf_H.e_phnum * p->elf_H.e_phentsize);
+}
+
+
+
+/***********************************************************************
+ * OS ELF read at
+ *
+ * @brief This function reads a block of the elf file in a single access
+ *
+ * @param lfs_file_t* lfs_file	: [ in] File pointer to the elf file
+ * @param uint32_t offset 		: [ in] Position of the block in the file
+ * @param void* buf 			: [out] Buffer receiving the block
+ * @param uint32_t size 		: [ in] Size of the block
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_readAt(lfs_file_t* lfs_file, uint32_t offset, void* buf, uint32_t size){
+
+	if(lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)offset, LFS_SEEK_SET) < 0)
+		return OS_ERR_FS;
+
+	lfs_ssize_t read = lfs_file_read(&lfs, lfs_file, buf, size);
+	if(read < 0 || (uint32_t)read != size)
+		return OS_ERR_FS;
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF read block
+ *
+ * @brief This function allocates a buffer and reads a block of the elf file into it. A null terminator is added after the block
+ *
+ * @param lfs_file_t* lfs_file	: [ in] File pointer to the elf file
+ * @param uint32_t offset 		: [ in] Position of the block in the file
+ * @param uint32_t size 		: [ in] Size of the block
+ * @param os_err_e* err 		: [out] Error code
+ *
+ * @return void* : the buffer (to be freed with os_heap_free), NULL if error
+ **********************************************************************/
+static void* os_elf_readBlock(lfs_file_t* lfs_file, uint32_t offset, uint32_t size, os_err_e* err){
+
+	uint8_t* buf = (uint8_t*)os_heap_alloc(size + 1);
+	if(buf == NULL){
+		*err = OS_ERR_INSUFFICIENT_HEAP;
+		return NULL;
+	}
+
+	*err = os_elf_readAt(lfs_file, offset, buf, size);
+	if(*err != OS_ERR_OK){
+		os_heap_free(buf);
+		return NULL;
+	}
+
+	buf[size] = 0;
+	return buf;
+}
+
+
+/***********************************************************************
+ * OS ELF text key
+ *
+ * @brief This function computes the key of a program from its headers and the bytes of its text, so that a rebuild keeping
+ * the same layout and sizes never matches the text of the previous build. It reads the whole text
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_elf_programHeader_t* text 	: [ in] Text segment
+ * @param uint32_t* key 				: [out] The key
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_textKey(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_elf_programHeader_t* text, uint32_t* key){
+
+	uint32_t h = os_elf_key(p, ctx);
+
+	uint8_t chunk[128];
+	for(uint32_t i = 0; i < text->p_filesz; i += sizeof(chunk)){
+
+		uint32_t n = text->p_filesz - i < sizeof(chunk) ? text->p_filesz - i : sizeof(chunk);
+		os_err_e ret = os_elf_readAt(lfs_file, text->p_offset + i, chunk, n);
+		if(ret != OS_ERR_OK)
+			return ret;
+
+		h = os_xip_hash(h, chunk, n);
+	}
+
+	*key = h;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF build key
+ *
+ * @brief This function computes the key of the installed image of a program. Programs linked with --build-id are identified
+ * by their build ID note, so only the note is read and the load time does not depend on the text size. Otherwise, the
+ * bytes of the text are hashed (see os_elf_textKey)
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_elf_programHeader_t* text 	: [ in] Text segment
+ * @param uint32_t* key 				: [out] The key
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_buildKey(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_elf_programHeader_t* text, uint32_t* key){
+
+	for(uint32_t i = 0; i < p->elf_H.e_shnum; i++){
+		os_elf_sectionHeader_t* sh = os_elf_section(p, ctx, i);
+
+		if(sh->sh_type != OS_ELF_SHT_NOTE || sh->sh_name >= ctx->shstrSize || strcmp(OS_ELF_BUILD_ID_SECTION, &ctx->shstr[sh->sh_name]) != 0)
+			continue;
+
+		if(sh->sh_size == 0 || sh->sh_size > OS_ELF_BUILD_ID_MAX_SIZE)
+			break;
+
+		/* Hash the note along with the headers
+		 ------------------------------------------------------*/
+		uint8_t note[OS_ELF_BUILD_ID_MAX_SIZE];
+		os_err_e ret = os_elf_readAt(lfs_file, sh->sh_offset, note, sh->sh_size);
+		if(ret != OS_ERR_OK)
+			return ret;
+
+		*key = os_xip_hash(os_elf_key(p, ctx), note, sh->sh_size);
+		return OS_ERR_OK;
+	}
+
+	return os_elf_textKey(p, lfs_file, ctx, text, key);
+}
+
+
 /***********************************************************************
  * OS ELF load header
  *
@@ -35,256 +629,930 @@ os_list_head_t os_process_list;				//Head of process list
  **********************************************************************/
 static os_err_e os_elf_loadHeader(os_elf_header_t* header, lfs_file_t* lfs_file){
 
-	/* Rewind file to the beginning
-	 ------------------------------------------------------*/
-	int err = lfs_file_seek(&lfs, lfs_file, 0, LFS_SEEK_SET);
-	if(err < 0){
-		return OS_ERR_FS;
-	}
+	/* Read the header
+	 ------------------------------------------------------*/
+	os_err_e ret = os_elf_readAt(lfs_file, 0, header, sizeof(*header));
+	if(ret != OS_ERR_OK){
+		return ret;
+	}
+
+	/* Check magic number
+	 ------------------------------------------------------*/
+	if(header->e_ident.magic[0] != 0x7F || header->e_ident.magic[1] != 'E' || header->e_ident.magic[2] != 'L' || header->e_ident.magic[3] != 'F'){
+		return OS_ERR_INVALID;
+	}
+
+	/* Check endianness, bit depth, and version
+	 ------------------------------------------------------*/
+	if(header->e_ident.class != 1 || header->e_ident.data != 1 || header->e_ident.version != 1){
+		return OS_ERR_INVALID;
+	}
+
+	/* Check version and that its made for ARM
+	 ------------------------------------------------------*/
+	if(header->e_machine != 40 || header->e_version != 1){
+		return OS_ERR_INVALID;
+	}
+
+	/* Check table entry sizes
+	 ------------------------------------------------------*/
+	if(header->e_phentsize < sizeof(os_elf_programHeader_t) || header->e_shentsize < sizeof(os_elf_sectionHeader_t)){
+		return OS_ERR_INVALID;
+	}
+
+	/* Return OK
+	 ------------------------------------------------------*/
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF load tables
+ *
+ * @brief This function reads the program header table, the section header table and the section names, each one in a single access
+ *
+ * @param os_process_t* p 			: [ in] Process reference
+ * @param lfs_file_t* lfs_file		: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 		: [out] Tables read
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_loadTables(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx){
+
+	os_err_e ret = OS_ERR_OK;
+
+	/* Program and section header tables
+	 ------------------------------------------------------*/
+	ctx->ph = os_elf_readBlock(lfs_file, p->elf_H.e_phoff, (uint32_t)(p->elf_H.e_phnum * p->elf_H.e_phentsize), &ret);
+	if(ctx->ph == NULL)
+		return ret;
+
+	ctx->sh = os_elf_readBlock(lfs_file, p->elf_H.e_shoff, (uint32_t)(p->elf_H.e_shnum * p->elf_H.e_shentsize), &ret);
+	if(ctx->sh == NULL)
+		return ret;
+
+	/* Section names
+	 ------------------------------------------------------*/
+	if(p->elf_H.e_shstrndx >= p->elf_H.e_shnum)
+		return OS_ERR_INVALID;
+
+	os_elf_sectionHeader_t* names = os_elf_section(p, ctx, p->elf_H.e_shstrndx);
+	ctx->shstrSize = names->sh_size;
+	ctx->shstr = os_elf_readBlock(lfs_file, names->sh_offset, names->sh_size, &ret);
+	if(ctx->shstr == NULL)
+		return ret;
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF free tables
+ *
+ * @brief This function frees the tables read by os_elf_loadTables
+ *
+ * @param os_elf_ctx_t* ctx : [in] Tables
+ **********************************************************************/
+static void os_elf_freeTables(os_elf_ctx_t* ctx){
+	os_heap_free(ctx->ph);
+	os_heap_free(ctx->sh);
+	os_heap_free(ctx->shstr);
+
+	ctx->ph = NULL;
+	ctx->sh = NULL;
+	ctx->shstr = NULL;
+}
+
+
+/***********************************************************************
+ * OS ELF check in place
+ *
+ * @brief This function checks that the loader never needs to patch the text segment, so that it can be executed from flash
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_elf_programHeader_t* text 	: [ in] Text segment
+ *
+ * @return os_err_e : <0 if error. OS_ERR_INVALID if the text is patched
+ **********************************************************************/
+static os_err_e os_elf_checkInPlace(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_elf_programHeader_t* text){
+
+	bool dynRel = false;
+
+	/* Dynamic relocations must not target the text
+	 ------------------------------------------------------*/
+	for(uint32_t i = 0; i < p->elf_H.e_shnum; i++){
+		os_elf_sectionHeader_t* data = os_elf_section(p, ctx, i);
+
+		if(data->sh_type != OS_ELF_SHT_REL || (data->sh_flags & OS_ELF_SHF_ALLOC) == 0)
+			continue;
+
+		dynRel = true;
+
+		os_elf_rel_t chunk[16];
+		uint32_t relNum = data->sh_size / sizeof(os_elf_rel_t);
+		for(uint32_t j = 0; j < relNum; j += COUNTOF(chunk)){
+
+			uint32_t n = relNum - j < COUNTOF(chunk) ? relNum - j : COUNTOF(chunk);
+			os_err_e ret = os_elf_readAt(lfs_file, data->sh_offset + j * sizeof(os_elf_rel_t), chunk, n * sizeof(os_elf_rel_t));
+			if(ret != OS_ERR_OK)
+				return ret;
+
+			/* Reject offsets where r_offset + 4 would wrap on a hostile ELF, before the overlap check computes it
+			 ------------------------------------------------------*/
+			for(uint32_t k = 0; k < n; k++){
+				uint32_t off = chunk[k].r_offset;
+
+				if(off > UINT32_MAX - sizeof(uint32_t))
+					return OS_ERR_INVALID;
+
+				if(off + sizeof(uint32_t) > text->p_vaddr && off < text->p_vaddr + text->p_memsz)
+					return OS_ERR_INVALID;
+			}
+		}
+	}
+
+	if(dynRel)
+		return OS_ERR_OK;
+
+	/* Otherwise, the sections rebased by name must not be in the text
+	 ------------------------------------------------------*/
+	for(uint32_t i = 0; i < p->elf_H.e_shnum; i++){
+		os_elf_sectionHeader_t* data = os_elf_section(p, ctx, i);
+
+		if(data->sh_name >= ctx->shstrSize)
+			continue;
+
+		char const* sect_name = &ctx->shstr[data->sh_name];
+		if(strcmp(".got", sect_name) != 0 && strcmp(".preinit_array", sect_name) != 0 && strcmp(".init_array", sect_name) != 0 && strcmp(".fini_array", sect_name) != 0)
+			continue;
+
+		if(data->sh_size > 0 && data->sh_addr + data->sh_size > text->p_vaddr && data->sh_addr < text->p_vaddr + text->p_memsz)
+			return OS_ERR_INVALID;
+	}
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF text acquire
+ *
+ * @brief This function gets the shared RAM copy of the text of a program, loading it on the first use
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_elf_programHeader_t* text 	: [ in] Text segment
+ * @param uint32_t key 					: [ in] Key of the program (see os_elf_buildKey)
+ *
+ * @return uint8_t* : the text, NULL if it cannot be shared (the process must load a private copy)
+ **********************************************************************/
+static uint8_t* os_elf_textAcquire(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_elf_programHeader_t* text, uint32_t key){
+
+	/* Search the text loaded by another instance, without reading the file. A file rebuilt meanwhile has another key
+	 ------------------------------------------------------*/
+	os_scheduler_lock();
+
+	for(os_list_cell_t* it = os_text_list.head.next; it != NULL; it = it->next){
+		os_elf_text_t* t = (os_elf_text_t*)it->element;
+
+		if(t->key == key && t->size == text->p_memsz && strcmp(t->name, p->p_name) == 0){
+			t->refs++;
+			p->textCache = t;
+
+			os_scheduler_unlock();
+			return t->data;
+		}
+	}
+
+	os_scheduler_unlock();
+
+	/* First instance. The text can only be shared if nobody patches it
+	 ------------------------------------------------------*/
+	if(os_elf_checkInPlace(p, lfs_file, ctx, text) != OS_ERR_OK)
+		return NULL;
+
+	os_elf_text_t* t = (os_elf_text_t*)os_heap_alloc(sizeof(os_elf_text_t));
+	if(t == NULL)
+		return NULL;
+
+	t->name = (char*)os_heap_alloc(strlen(p->p_name) + 1);
+	t->data = (uint8_t*)os_heap_alloc(text->p_memsz);
+	t->key = key;
+	t->size = text->p_memsz;
+	t->refs = 1;
+
+	if(t->name == NULL || t->data == NULL || os_elf_readAt(lfs_file, text->p_offset, t->data, text->p_memsz) != OS_ERR_OK)
+		goto error;
+
+	strcpy(t->name, p->p_name);
+
+	/* Publish it
+	 ------------------------------------------------------*/
+	os_scheduler_lock();
+	os_err_e ret = os_list_add(&os_text_list, t, OS_LIST_FIRST);
+	os_scheduler_unlock();
+
+	if(ret != OS_ERR_OK)
+		goto error;
+
+	p->textCache = t;
+	return t->data;
+
+error:
+	os_heap_free(t->name);
+	os_heap_free(t->data);
+	os_heap_free(t);
+
+	return NULL;
+}
+
+
+/***********************************************************************
+ * OS ELF text release
+ *
+ * @brief This function drops the reference of a process to its shared RAM text. The last process frees it
+ *
+ * @param os_process_t* p : [in] Process reference
+ **********************************************************************/
+static void os_elf_textRelease(os_process_t* p){
+
+	os_elf_text_t* t = (os_elf_text_t*)p->textCache;
+	if(t == NULL)
+		return;
+
+	p->textCache = NULL;
 
-	/* Read the header
-	 ------------------------------------------------------*/
-	err = lfs_file_read(&lfs, lfs_file, header, sizeof(*header));
-	if(err < 0){
-		return OS_ERR_FS;
-	}
+	os_scheduler_lock();
 
-	/* Check magic number
-	 ------------------------------------------------------*/
-	if(header->e_ident.magic[0] != 0x7F || header->e_ident.magic[1] != 'E' || header->e_ident.magic[2] != 'L' || header->e_ident.magic[3] != 'F'){
-		return OS_ERR_INVALID;
-	}
+	bool last = --t->refs == 0;
+	if(last)
+		os_list_remove(&os_text_list, t);
 
-	/* Check endianness, bit depth, and version
-	 ------------------------------------------------------*/
-	if(header->e_ident.class != 1 || header->e_ident.data != 1 || header->e_ident.version != 1){
-		return OS_ERR_INVALID;
-	}
+	os_scheduler_unlock();
 
-	/* Check version and that its made for ARM
-	 ------------------------------------------------------*/
-	if(header->e_machine != 40 || header->e_version != 1){
-		return OS_ERR_INVALID;
-	}
+	if(!last)
+		return;
 
-	/* Return OK
-	 ------------------------------------------------------*/
-	return OS_ERR_OK;
+	os_heap_free(t->name);
+	os_heap_free(t->data);
+	os_heap_free(t);
 }
 
 
 /***********************************************************************
  * OS ELF load segments
  *
- * @brief This function loads all segments into RAM
+ * @brief This function loads all segments into RAM. The text of the program is executed in place if installed, or shared with the
+ * other instances of the program, so that only the writable segments are loaded for each process
  *
  * @param os_process_t* p 			: [ in] Process reference
  * @param lfs_file_t* lfs_file		: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 		: [ in] Tables of the elf file, [out] Loaded segments
+ * @param uint32_t reserve 			: [ in] Room the process needs in its arena besides the segments
  *
  * @return os_err_e : <0 if error
  **********************************************************************/
-static os_err_e os_elf_loadSegments(os_process_t* p, lfs_file_t* lfs_file){
+static os_err_e os_elf_loadSegments(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, uint32_t reserve){
+
+	/* Search the installed text, otherwise share it in RAM
+	 ------------------------------------------------------*/
+	uint8_t const* shared = NULL;
+	os_elf_programHeader_t* text = os_elf_textSegment(p, ctx);
+	if(text != NULL){
+		uint32_t key = 0;
+		os_err_e ret = os_elf_buildKey(p, lfs_file, ctx, text, &key);
+		if(ret != OS_ERR_OK)
+			return ret;
+
+		p->text = os_xip_find(p->p_name, key, text->p_memsz);
+		shared = p->text != NULL ? p->text : os_elf_textAcquire(p, lfs_file, ctx, text, key);
+	}
+
+	if(shared == NULL)
+		text = NULL;
 
-	/* First, calculate how much RAM we need
+	/* Then, calculate how much RAM we need
 	 ------------------------------------------------------*/
 	uint32_t memToAlloc = 0;
 
-	/* For each segment
+	/* For each LOAD segment, align segment block as 8 byte
 	 ------------------------------------------------------*/
 	for(uint32_t i = 0; i < p->elf_H.e_phnum; i++){
+		os_elf_programHeader_t* data = os_elf_segment(p, ctx, i);
 
-		/* read program header data
-		 ------------------------------------------------------*/
-		os_elf_programHeader_t data;
-		int err  = lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)(p->elf_H.e_phoff + i * p->elf_H.e_phentsize), LFS_SEEK_SET); //Seek to the program header position
-		    err |= lfs_file_read(&lfs, lfs_file, &data, sizeof(data));
-		if(err < 0){
-			return OS_ERR_FS;
-		}
-
-		/* Check that it is a LOAD segment
-		 ------------------------------------------------------*/
-		if(data.p_type != 1)
-			continue;
-
-		/* align segment block as 8 byte
-		 ------------------------------------------------------*/
-		memToAlloc += (data.p_memsz + 7) & (~0x7UL);
+		if(data->p_type == OS_ELF_PT_LOAD && data != text)
+			memToAlloc += (data->p_memsz + 7) & (~0x7UL);
 	}
 
-	/* Allocate all segments to make the free easier
+	/* Allocate all segments in the process arena
 	 ------------------------------------------------------*/
-	p->segments = (uint8_t*) os_heap_alloc(memToAlloc);
-	if(p->segments == NULL)
-		return OS_ERR_INSUFFICIENT_HEAP;
+	os_err_e ret = os_process_arenaCreate(p, memToAlloc, reserve);
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	p->segSize = memToAlloc;
 
 	/* Initialize segments to 0 and Load into memory
 	 ------------------------------------------------------*/
 	size_t pos = 0;
-	memset(p->segments, 0, memToAlloc);
+	if(p->segments != NULL)
+		memset(p->segments, 0, memToAlloc);
 
 	/* For each segment
 	 ------------------------------------------------------*/
 	for(uint32_t i = 0; i < p->elf_H.e_phnum; i++){
+		os_elf_programHeader_t* data = os_elf_segment(p, ctx, i);
 
-		/* Read program header data
+		/* Check it is LOAD segment
 		 ------------------------------------------------------*/
-		os_elf_programHeader_t data;
-		int err  = lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)(p->elf_H.e_phoff + i * p->elf_H.e_phentsize), LFS_SEEK_SET); //Seek to the program header position
-		 	err |= lfs_file_read(&lfs, lfs_file, &data, sizeof(data));
-		if(err < 0){
-			os_heap_free(p->segments);
-			p->segments = NULL;
-			return OS_ERR_FS;
-		}
+		if(data->p_type != OS_ELF_PT_LOAD)
+			continue;
 
-		/* Check it is LOAD segment
+		if(ctx->mapNum >= OS_ELF_MAP_MAX)
+			return OS_ERR_INVALID;
+
+		os_elf_map_t* m = &ctx->map[ctx->mapNum++];
+		m->vaddr = data->p_vaddr;
+		m->memsz = data->p_memsz;
+
+		/* Shared text is used in place
 		 ------------------------------------------------------*/
-		if(data.p_type != 1)
+		if(data == text){
+			m->host = (uint8_t*)shared;
+			m->readOnly = true;
 			continue;
+		}
+
+		m->host = &p->segments[pos];
+		m->readOnly = false;
 
 		/* Read the entire segment into the heap
 		 ------------------------------------------------------*/
-		err  = lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)data.p_offset, LFS_SEEK_SET); //Seek to the actual data
-		err |= lfs_file_read(&lfs, lfs_file, &p->segments[pos], data.p_filesz);
-		if(err < 0){
-			os_heap_free(p->segments);
-			p->segments = NULL;
+		if(data->p_filesz > data->p_memsz || os_elf_readAt(lfs_file, data->p_offset, &p->segments[pos], data->p_filesz) != OS_ERR_OK){
 			return OS_ERR_FS;
 		}
 
-		/* Calculate segment size
-		 ------------------------------------------------------*/
-		size_t segmentSize = (data.p_memsz + 7) & (~0x7UL);
-
 		/* increment buffer position
 		 ------------------------------------------------------*/
-		pos += segmentSize;
+		pos += (data->p_memsz + 7) & (~0x7UL);
+	}
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF resolve symbol
+ *
+ * @brief This function computes the address of a symbol. Symbols defined by the program are rebased, imports are bound to the kernel function with the same name
+ *
+ * @param os_elf_ctx_t* ctx 			: [ in] Loaded segments
+ * @param os_elf_symbol_t* sym 			: [ in] Symbol
+ * @param char const* strtab 			: [ in] String table of the symbol table
+ * @param uint32_t strtabSize 			: [ in] Size of the string table
+ * @param uint32_t* addr 				: [out] Address of the symbol
+ *
+ * @return os_err_e : <0 if error. OS_ERR_INVALID if an import does not exist in the kernel
+ **********************************************************************/
+static os_err_e os_elf_resolveSymbol(os_elf_ctx_t* ctx, os_elf_symbol_t* sym, char const* strtab, uint32_t strtabSize, uint32_t* addr){
+
+	/* Defined in the program, rebase it
+	 ------------------------------------------------------*/
+	if(sym->st_shndx != 0){
+		*addr = os_elf_rebase(ctx, sym->st_value);
+		return OS_ERR_OK;
 	}
 
+	/* Import, bind it to the kernel
+	 ------------------------------------------------------*/
+	if(sym->st_name >= strtabSize)
+		return OS_ERR_INVALID;
+
+	void* fn = os_sl_translate((char*)&strtab[sym->st_name]);
+	if(fn == NULL){
+		PRINTLN("Unresolved symbol %s", &strtab[sym->st_name]);
+		return OS_ERR_INVALID;
+	}
+
+	*addr = (uint32_t)fn;
 	return OS_ERR_OK;
 }
 
 
+/***********************************************************************
+ * OS ELF relocate
+ *
+ * @brief This function applies every entry of a dynamic relocation section (.rel.dyn, .rel.plt) to the loaded segments.
+ * The linked symbol and string tables are read once, the entries are read by chunks.
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_elf_sectionHeader_t* rel 	: [ in] Relocation section
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_relocate(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_elf_sectionHeader_t* rel){
+
+	/* Load linked symbol and string tables
+	 ------------------------------------------------------*/
+	if(rel->sh_link >= p->elf_H.e_shnum)
+		return OS_ERR_INVALID;
+
+	os_elf_sectionHeader_t* symtab = os_elf_section(p, ctx, rel->sh_link);
+	if(symtab->sh_link >= p->elf_H.e_shnum)
+		return OS_ERR_INVALID;
+
+	os_elf_sectionHeader_t* strtab = os_elf_section(p, ctx, symtab->sh_link);
+
+	os_err_e ret = OS_ERR_OK;
+	os_elf_symbol_t* syms = os_elf_readBlock(lfs_file, symtab->sh_offset, symtab->sh_size, &ret);
+	char* strs = os_elf_readBlock(lfs_file, strtab->sh_offset, strtab->sh_size, &ret);
+	if(syms == NULL || strs == NULL)
+		goto exit;
+
+	uint32_t symNum = symtab->sh_size / sizeof(os_elf_symbol_t);
+	uint32_t relNum = rel->sh_size / sizeof(os_elf_rel_t);
+
+	/* For each chunk of relocations
+	 ------------------------------------------------------*/
+	os_elf_rel_t chunk[16];
+	for(uint32_t i = 0; i < relNum; i += COUNTOF(chunk)){
+
+		uint32_t n = relNum - i < COUNTOF(chunk) ? relNum - i : COUNTOF(chunk);
+		ret = os_elf_readAt(lfs_file, rel->sh_offset + i * sizeof(os_elf_rel_t), chunk, n * sizeof(os_elf_rel_t));
+		if(ret != OS_ERR_OK)
+			goto exit;
+
+		for(uint32_t j = 0; j < n; j++){
+
+			/* Check location (installed text cannot be patched)
+			 ------------------------------------------------------*/
+			uint32_t* pMem = (uint32_t*) os_elf_map(ctx, chunk[j].r_offset, sizeof(uint32_t), true);
+			if(pMem == NULL){
+				ret = OS_ERR_INVALID;
+				goto exit;
+			}
+
+			uint32_t type = chunk[j].r_info & 0xFF;
+			uint32_t symIndex = chunk[j].r_info >> 8;
+			uint32_t symAddr = 0;
+
+			/* Resolve the symbol when the relocation uses one
+			 ------------------------------------------------------*/
+			if(type == OS_ELF_R_ARM_ABS32 || type == OS_ELF_R_ARM_GLOB_DAT || type == OS_ELF_R_ARM_JUMP_SLOT){
+				ret = symIndex < symNum ? os_elf_resolveSymbol(ctx, &syms[symIndex], strs, strtab->sh_size, &symAddr) : OS_ERR_INVALID;
+				if(ret != OS_ERR_OK)
+					goto exit;
+			}
+
+			/* Patch
+			 ------------------------------------------------------*/
+			switch(type){
+				case OS_ELF_R_ARM_RELATIVE 	: *pMem = os_elf_rebase(ctx, *pMem); break;
+				case OS_ELF_R_ARM_ABS32 	: *pMem = symAddr + *pMem; break;
+				case OS_ELF_R_ARM_GLOB_DAT 	:
+				case OS_ELF_R_ARM_JUMP_SLOT : *pMem = symAddr; break;
+				default :
+					PRINTLN("Unsupported relocation %lu", type);
+					ret = OS_ERR_INVALID;
+					goto exit;
+			}
+		}
+	}
+
+exit:
+	os_heap_free(syms);
+	os_heap_free(strs);
+
+	return ret;
+}
+
+
 /***********************************************************************
  * OS ELF Adjust Memory references
  *
  * @brief This function adjusts the Global Offset Table of the program. When compiled with Position Independent Code (-fPIC), the code gets all globals using the GOT
- * This GOT must be corrected to the actual address we are loading. This is also the case for some other sections
+ * This GOT must be corrected to the actual address we are loading. This is also the case for some other sections.
+ * Programs linked with dynamic relocations (-pie) are patched using their relocation tables instead, which also binds their imports to the kernel once.
  *
  * @param os_process_t* p 			: [ in] Process reference
  * @param lfs_file_t* lfs_file		: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 		: [ in] Tables of the elf file
  *
  * @return os_elf_prog_t : information needed to run an executable
  **********************************************************************/
-static os_err_e os_elf_adjustMem(os_process_t* p, lfs_file_t* lfs_file){
+static os_err_e os_elf_adjustMem(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx){
 
-	/* Load section header that contains the names of the sections
+	/* Check for dynamic relocations. If there are any, they already cover the sections rebased by name
 	 ------------------------------------------------------*/
-	os_elf_sectionHeader_t names;
-	int err  = lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)(p->elf_H.e_shoff + (uint32_t)(p->elf_H.e_shstrndx * p->elf_H.e_shentsize) ), LFS_SEEK_SET); //Seek to the index of the section header that contains all names
-		err |= lfs_file_read(&lfs, lfs_file, &names, sizeof(names));
-	if(err < 0){
-		return OS_ERR_FS;
+	bool dynRel = false;
+	for(uint32_t i = 0; i < p->elf_H.e_shnum && !dynRel; i++){
+		os_elf_sectionHeader_t* data = os_elf_section(p, ctx, i);
+		dynRel = data->sh_type == OS_ELF_SHT_REL && (data->sh_flags & OS_ELF_SHF_ALLOC) != 0;
 	}
 
 	/* For each section
 	 ------------------------------------------------------*/
 	for(uint32_t i = 0; i < p->elf_H.e_shnum; i++){
+		os_elf_sectionHeader_t* data = os_elf_section(p, ctx, i);
 
-		/* read section header information
+		/* Apply dynamic relocations
 		 ------------------------------------------------------*/
-		os_elf_sectionHeader_t data;
-		int err  = lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)(p->elf_H.e_shoff + i * p->elf_H.e_shentsize), LFS_SEEK_SET); //Seek to the section header
-			err |= lfs_file_read(&lfs, lfs_file, &data, sizeof(data));
-		if(err < 0){
-			return OS_ERR_FS;
+		if(data->sh_type == OS_ELF_SHT_REL && (data->sh_flags & OS_ELF_SHF_ALLOC) != 0){
+			os_err_e ret = os_elf_relocate(p, lfs_file, ctx, data);
+			if(ret != OS_ERR_OK){
+				return ret;
+			}
+
+			continue;
 		}
 
 		/* Get the name of the current section
 		 ------------------------------------------------------*/
-		char sect_name[32];
-		memset(sect_name, 0, sizeof(sect_name));
+		if(data->sh_name >= ctx->shstrSize)
+			continue;
+
+		char const* sect_name = &ctx->shstr[data->sh_name];
+
+		if(strcmp(".got", sect_name) == 0){
+			p->gotBaseAddr = os_elf_rebase(ctx, data->sh_addr);
+		}
+
+		/* These sections need correction when there is no relocation table
+		 ------------------------------------------------------*/
+		if(dynRel)
+			continue;
+
+		if(strcmp(".got", sect_name) != 0 && strcmp(".preinit_array", sect_name) != 0 && strcmp(".init_array", sect_name) != 0 && strcmp(".fini_array", sect_name) != 0)
+			continue;
+
+		uint32_t* pMem = (uint32_t*) os_elf_map(ctx, data->sh_addr, data->sh_size, true);
+		if(pMem == NULL)
+			return OS_ERR_INVALID;
+
+		for(int j = 0; j < (int)data->sh_size; j += (int) sizeof(uint32_t)){ //Move in increments of 4 bytes
+			pMem[j/4] = os_elf_rebase(ctx, pMem[j/4]);
+		}
+	}
+
+	/* Finally, calculate the entry point
+	 ------------------------------------------------------*/
+	uint32_t entry = os_elf_rebase(ctx, p->elf_H.e_entry);
+	entry |= 0x01;
+
+	p->entry_fn = (void*)entry;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF read manifest
+ *
+ * @brief This function reads the .os_manifest section of the ELF file, if any, and applies it to the launch parameters
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_process_params_t* params 	: [ in] Launch parameters, [out] Launch parameters requested by the program
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_readManifest(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_process_params_t* params){
+
+	for(uint32_t i = 0; i < p->elf_H.e_shnum; i++){
+		os_elf_sectionHeader_t* sh = os_elf_section(p, ctx, i);
+
+		if(sh->sh_name >= ctx->shstrSize || strcmp(OS_MANIFEST_SECTION, &ctx->shstr[sh->sh_name]) != 0)
+			continue;
+
+		/* Read and apply it
+		 ------------------------------------------------------*/
+		os_manifest_t m;
+		if(sh->sh_size < sizeof(m))
+			return OS_ERR_INVALID;
+
+		os_err_e ret = os_elf_readAt(lfs_file, sh->sh_offset, &m, sizeof(m));
+		if(ret != OS_ERR_OK)
+			return ret;
+
+		return os_process_applyManifest(params, &m);
+	}
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS ELF load
+ *
+ * @brief This function loads an ELF file: tables, manifest, segments and relocations
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_process_params_t* params 	: [ in] Default launch parameters, [out] Launch parameters requested by the program
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_load(os_process_t* p, lfs_file_t* lfs_file, os_process_params_t* params){
+
+	os_elf_ctx_t ctx = { 0 };
+
+	/* Load header information
+	 --------------------------------------------------*/
+	os_err_e ret = os_elf_loadHeader(&p->elf_H, lfs_file);
+	if(ret != OS_ERR_OK) {
+		PRINTLN("Error loading header");
+		goto exit;
+	}
+
+	/* Load header tables
+	 --------------------------------------------------*/
+	ret = os_elf_loadTables(p, lfs_file, &ctx);
+	if(ret != OS_ERR_OK) {
+		PRINTLN("Error loading tables");
+		goto exit;
+	}
+
+	/* Launch parameters requested by the program
+	 --------------------------------------------------*/
+	ret = os_elf_readManifest(p, lfs_file, &ctx, params);
+	if(ret != OS_ERR_OK) {
+		PRINTLN("Error loading manifest");
+		goto exit;
+	}
+
+	/* Load segments information
+	 --------------------------------------------------*/
+	ret = os_elf_loadSegments(p, lfs_file, &ctx, os_process_reserve(params));
+	if(ret != OS_ERR_OK) {
+		PRINTLN("Error loading data");
+		goto exit;
+	}
+
+	/* Fix memory references
+	 --------------------------------------------------*/
+	ret = os_elf_adjustMem(p, lfs_file, &ctx);
+	if(ret != OS_ERR_OK) {
+		PRINTLN("Error loading GOT");
+		goto exit;
+	}
+
+exit:
+	os_elf_freeTables(&ctx);
+
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS ELF install text
+ *
+ * @brief This function copies the text segment to the installed image area by chunks
+ *
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the elf file
+ * @param os_elf_ctx_t* ctx 			: [ in] Tables of the elf file
+ * @param os_elf_programHeader_t* text 	: [ in] Text segment
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_elf_installText(os_process_t* p, lfs_file_t* lfs_file, os_elf_ctx_t* ctx, os_elf_programHeader_t* text){
+
+	/* Already installed, nothing to do
+	 ------------------------------------------------------*/
+	uint32_t key = 0;
+	os_err_e ret = os_elf_buildKey(p, lfs_file, ctx, text, &key);
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	if(os_xip_find(p->p_name, key, text->p_memsz) != NULL)
+		return OS_ERR_OK;
+
+	/* Reserve the image
+	 ------------------------------------------------------*/
+	uint32_t addr = 0;
+	ret = os_xip_reserve(p->p_name, key, text->p_memsz, &addr);
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	/* Copy the text
+	 ------------------------------------------------------*/
+	uint8_t chunk[256];
+	for(uint32_t i = 0; i < text->p_filesz; i += sizeof(chunk)){
+
+		uint32_t n = text->p_filesz - i < sizeof(chunk) ? text->p_filesz - i : sizeof(chunk);
+		ret = os_elf_readAt(lfs_file, text->p_offset + i, chunk, n);
+		if(ret != OS_ERR_OK)
+			return ret;
+
+		if(os_flash_write(addr + i, chunk, n) < 0)
+			return OS_ERR_UNKNOWN;
+	}
+
+	/* Validate it
+	 ------------------------------------------------------*/
+	return os_xip_commit(addr);
+}
+
+
+//////////////////////////////////////////////// PACKED IMAGE LOADER //////////////////////////////////////////////////
+
+
+/***********************************************************************
+ * OS Pack read
+ *
+ * @brief This function reads the next block of a packed image. Packed images are read in a single pass, without seeking
+ *
+ * @param lfs_file_t* lfs_file	: [ in] File pointer to the image
+ * @param void* buf 			: [out] Buffer receiving the block
+ * @param uint32_t size 		: [ in] Size of the block
+ *
+ * @return os_err_e : <0 if error
+ **********************************************************************/
+static os_err_e os_pack_read(lfs_file_t* lfs_file, void* buf, uint32_t size){
+
+	lfs_ssize_t read = lfs_file_read(&lfs, lfs_file, buf, size);
+	if(read < 0 || (uint32_t)read != size)
+		return OS_ERR_FS;
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Pack bind imports
+ *
+ * @brief This function reads the imports of a packed image and binds them to the kernel
+ *
+ * @param os_process_t* p 			: [ in] Process reference
+ * @param lfs_file_t* lfs_file		: [ in] File pointer to the image
+ * @param uint32_t importNum 		: [ in] Number of imports
+ *
+ * @return os_err_e : <0 if error. OS_ERR_INVALID if an import does not exist in the kernel
+ **********************************************************************/
+static os_err_e os_pack_bindImports(os_process_t* p, lfs_file_t* lfs_file, uint32_t importNum){
+
+	char name[OS_ELF_SYM_NAME_MAX];
+
+	for(uint32_t i = 0; i < importNum; i++){
+
+		/* Read entry and name
+		 ------------------------------------------------------*/
+		os_pack_import_t imp;
+		os_err_e ret = os_pack_read(lfs_file, &imp, sizeof(imp));
+		if(ret != OS_ERR_OK)
+			return ret;
 
-		err  = lfs_file_seek(&lfs, lfs_file, (lfs_soff_t)(data.sh_name + names.sh_offset), LFS_SEEK_SET); //Seek to the string position in the file
-		err |= lfs_file_read(&lfs, lfs_file, sect_name, sizeof(sect_name));
-		if(err < 0){
-			return OS_ERR_FS;
-		}
+		uint32_t padded = (imp.nameLen + 3) & (~0x3UL);
+		if(padded >= sizeof(name) || (imp.offset & 0x3) != 0 || imp.offset > p->segSize - sizeof(uint32_t))
+			return OS_ERR_INVALID;
 
-		/* These sections need correction
-		 ------------------------------------------------------*/
-		if(strcmp(".got", sect_name) != 0 && strcmp(".preinit_array", sect_name) != 0 && strcmp(".init_array", sect_name) != 0 && strcmp(".fini_array", sect_name) != 0)
-			continue;
+		ret = os_pack_read(lfs_file, name, padded);
+		if(ret != OS_ERR_OK)
+			return ret;
 
-		uint32_t* pMem = (uint32_t*) &p->segments[data.sh_addr];
-		for(int j = 0; j < (int)data.sh_size; j += (int) sizeof(uint32_t)){ //Move in increments of 4 bytes
-			pMem[j/4] = (uint32_t)p->segments + pMem[j/4];
-		}
+		name[imp.nameLen] = 0;
 
-		if(strcmp(".got", sect_name) == 0){
-			p->gotBaseAddr = (uint32_t)p->segments + data.sh_addr;
+		/* Bind
+		 ------------------------------------------------------*/
+		void* fn = os_sl_translate(name);
+		if(fn == NULL){
+			PRINTLN("Unresolved symbol %s", name);
+			return OS_ERR_INVALID;
 		}
-	}
 
-	/* Finally, calculate the entry point
-	 ------------------------------------------------------*/
-	uint32_t entry = p->elf_H.e_entry;
-	entry += (uint32_t)p->segments;
-	entry |= 0x01;
+		*(uint32_t*)&p->segments[imp.offset] += (uint32_t)fn;
+	}
 
-	p->entry_fn = (void*)entry;
 	return OS_ERR_OK;
 }
 
 
-/**********************************************
- * OS PUBLIC FUNCTIONS
- *********************************************/
-
 /***********************************************************************
- * OS Process get by PID
- *
- * @brief This function searches for a process with a giben PID
+ * OS Pack load
  *
- * @param uint16_t pid : [in] PID to search
+ * @brief This function loads a packed image in a single sequential read of the file. The payload is relocated while it is streamed
  *
- * @return os_process_t* : reference to found process
+ * @param os_process_t* p 				: [ in] Process reference
+ * @param lfs_file_t* lfs_file			: [ in] File pointer to the image
+ * @param os_process_params_t* params 	: [ in] Default launch parameters, [out] Launch parameters requested by the program
  *
+ * @return os_err_e : <0 if error
  **********************************************************************/
-os_process_t* os_process_getByPID(uint16_t pid){
-	if(pid == 0) return NULL;
+static os_err_e os_pack_load(os_process_t* p, lfs_file_t* lfs_file, os_process_params_t* params){
 
-	os_list_cell_t* it = os_process_list.head.next;
-	while(it != NULL){
-		if( ((os_process_t*)it->element)->PID == pid )
-			return it->element;
+	/* Read and check header
+	 ------------------------------------------------------*/
+	os_pack_header_t hdr;
+	os_err_e ret = os_elf_readAt(lfs_file, 0, &hdr, sizeof(hdr));
+	if(ret != OS_ERR_OK)
+		return ret;
 
-		it = it->next;
+	if(hdr.magic != OS_PACK_MAGIC || hdr.version != OS_PACK_VERSION || hdr.headerSize != sizeof(hdr))
+		return OS_ERR_INVALID;
+
+	if(((hdr.textSize | hdr.dataSize) & 0x3) != 0)
+		return OS_ERR_INVALID;
+
+	uint32_t payload = hdr.textSize + hdr.dataSize;
+	uint32_t memSize = (payload + hdr.bssSize + 7) & (~0x7UL);
+	if(payload < hdr.textSize || memSize < payload || hdr.entry >= payload || hdr.got > payload)
+		return OS_ERR_INVALID;
+
+	/* Launch parameters requested by the program
+	 ------------------------------------------------------*/
+	ret = os_process_applyManifest(params, &hdr.manifest);
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	/* Allocate image in the process arena, bss is zeroed
+	 ------------------------------------------------------*/
+	ret = os_process_arenaCreate(p, memSize, os_process_reserve(params));
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	p->segSize = memSize;
+	memset(&p->segments[payload], 0, memSize - payload);
+
+	/* Read relocation bitmap
+	 ------------------------------------------------------*/
+	uint32_t words = payload / sizeof(uint32_t);
+	uint32_t* bitmap = (uint32_t*) os_heap_alloc(((words + 31) / 32) * sizeof(uint32_t));
+	if(bitmap == NULL)
+		return OS_ERR_INSUFFICIENT_HEAP;
+
+	ret = os_pack_read(lfs_file, bitmap, ((words + 31) / 32) * sizeof(uint32_t));
+	if(ret != OS_ERR_OK)
+		goto exit;
+
+	/* Stream payload, relocating each chunk once read
+	 ------------------------------------------------------*/
+	uint32_t* image = (uint32_t*) p->segments;
+	for(uint32_t i = 0; i < words; i += 128){
+
+		uint32_t n = words - i < 128 ? words - i : 128;
+		ret = os_pack_read(lfs_file, &image[i], n * sizeof(uint32_t));
+		if(ret != OS_ERR_OK)
+			goto exit;
+
+		for(uint32_t j = i; j < i + n; j++){
+			if((bitmap[j / 32] >> (j % 32)) & 0x1)
+				image[j] += (uint32_t)p->segments;
+		}
 	}
 
-	return NULL;
+	/* Bind imports
+	 ------------------------------------------------------*/
+	ret = os_pack_bindImports(p, lfs_file, hdr.importNum);
+	if(ret != OS_ERR_OK)
+		goto exit;
+
+	/* Entry point and GOT
+	 ------------------------------------------------------*/
+	p->entry_fn = (void*)(((uint32_t)p->segments + hdr.entry) | 0x01);
+	p->gotBaseAddr = (uint32_t)p->segments + hdr.got;
+
+exit:
+	os_heap_free(bitmap);
+
+	return ret;
 }
 
 
+//////////////////////////////////////////////// PROCESS LOAD //////////////////////////////////////////////////
+
+
 /***********************************************************************
- * OS Create process
+ * OS Process load
  *
- * @brief This function creates a process using its ELF file
+ * @brief This function loads a program and starts its main thread. Only the publication of the process is done with the scheduler locked.
+ * The FS mutex is held from the opening of the file until the process is registered
  *
- * @param char* file   : [in] File's name
- * @param void* argc   : [in] Argument number to be passed to the task
- * @param char* argv[] : [in] Array of strings to be passed to the task
+ * @param char* file   	: [ in] File's name
+ * @param void* argc   	: [ in] Argument number to be passed to the task
+ * @param char* argv[] 	: [ in] Array of strings to be passed to the task
+ * @param uint16_t* pid : [out] PID of the new process
  *
  * @return os_err_e : An error code (0 = OK)
  *
  **********************************************************************/
-os_err_e os_process_create(char* file, int argc, char* argv[]){
+static os_err_e os_process_load(char* file, int argc, char* argv[], uint16_t* pid){
 
 	/* Allocate process
 	 --------------------------------------------------*/
 	os_err_e ret = OS_ERR_OK;
-	os_scheduler_state_e sch = os_scheduler_state_get();
+	bool schLocked = false;
+	bool fsLocked = false;
+	os_process_params_t params = {
+		.stackSize 	= OS_DEFAULT_STACK_SIZE,
+		.heapSize 	= OS_PROCESS_HEAP_SIZE,
+		.argsSize 	= os_process_argsSize(argc, argv),
+		.priority 	= OS_PROCESS_DEFAULT_PRIO,
+	};
 
 	os_process_t* new_proc = (os_process_t*)os_heap_alloc(sizeof(os_process_t));
 	if(new_proc == NULL){
@@ -292,6 +1560,17 @@ os_err_e os_process_create(char* file, int argc, char* argv[]){
 		goto exit;
 	}
 
+	new_proc->segments = NULL;
+	new_proc->segSize = 0;
+	new_proc->arena = NULL;
+	new_proc->limits.heapQuota = OS_PROCESS_HEAP_QUOTA;
+	new_proc->limits.cpuShare = OS_PROCESS_CPU_SHARE;
+	new_proc->limits.maxThreads = OS_PROCESS_MAX_THREADS;
+	memset(&new_proc->usage, 0, sizeof(new_proc->usage));
+	new_proc->text = NULL;
+	new_proc->textCache = NULL;
+	new_proc->p_name = NULL;
+
 	/* Init thread list
 	 --------------------------------------------------*/
 	new_proc->thread_list = os_list_init();
@@ -302,25 +1581,25 @@ os_err_e os_process_create(char* file, int argc, char* argv[]){
 
 	/* Create a unique PID
 	 ------------------------------------------------------*/
-	uint16_t pid = 0;
+	uint16_t newPid = 0;
 	uint32_t attempts = 0;
 	while(1){
 
 		/* Generate PID using the tick
 		 ------------------------------------------------------*/
 		uint32_t ms = os_getMsTick() + attempts;
-		pid = (uint16_t)( (ms & 0xFF) ^ ((ms >> 16) & 0xFF) );
+		newPid = (uint16_t)( (ms & 0xFF) ^ ((ms >> 16) & 0xFF) );
 
 		/* Check if PID exists
 		 ------------------------------------------------------*/
-		if(os_process_getByPID(pid) == NULL && pid != 0){
+		if(os_process_getByPID(newPid) == NULL && newPid != 0){
 			break;
 		}
 
 		attempts++;
 	}
 
-	new_proc->PID = pid;
+	new_proc->PID = newPid;
 
 	/* Generate and copy name
 	 ------------------------------------------------------*/
@@ -333,6 +1612,14 @@ os_err_e os_process_create(char* file, int argc, char* argv[]){
 
 	snprintf(new_proc->p_name, len + 1, "%s", file);
 
+	/* Get FS mutex. The loader runs concurrently with the other FS users
+	 --------------------------------------------------*/
+	os_obj_single_wait(fsMutex, OS_WAIT_FOREVER, &ret);
+	if(ret != OS_ERR_OK)
+		goto exit;
+
+	fsLocked = true;
+
 	/* Open file
 	 --------------------------------------------------*/
 	lfs_file_t lfs_file;
@@ -343,38 +1630,40 @@ os_err_e os_process_create(char* file, int argc, char* argv[]){
 		goto exit;
 	}
 
-	/* Load header information
+	/* Load packed image or ELF file
 	 --------------------------------------------------*/
-	ret = os_elf_loadHeader(&new_proc->elf_H, &lfs_file);
+	uint32_t magic = 0;
+	ret = os_elf_readAt(&lfs_file, 0, &magic, sizeof(magic));
 	if(ret != OS_ERR_OK) {
 		PRINTLN("Error loading header");
 		goto exit_file;
 	}
 
-	/* Load segments information
-	 --------------------------------------------------*/
-	ret = os_elf_loadSegments(new_proc, &lfs_file);
-	if(ret != OS_ERR_OK) {
-		PRINTLN("Error loading data");
+	if(magic == OS_PACK_MAGIC)
+		ret = os_pack_load(new_proc, &lfs_file, &params);
+	else
+		ret = os_elf_load(new_proc, &lfs_file, &params);
+
+	if(ret != OS_ERR_OK)
 		goto exit_file;
-	}
 
-	/* Fix memory references
-	 --------------------------------------------------*/
-	ret = os_elf_adjustMem(new_proc, &lfs_file);
-	if(ret != OS_ERR_OK) {
-		PRINTLN("Error loading GOT");
+	/* Copy the arguments to the arena
+	 ------------------------------------------------------*/
+	char** args = argc > 0 && argv != NULL ? os_process_argsCopy(new_proc, argc, argv) : NULL;
+	if(argc > 0 && argv != NULL && args == NULL){
+		ret = OS_ERR_INSUFFICIENT_HEAP;
 		goto exit_file;
 	}
 
-	/* Stop scheduler to finish loading
+	/* Lock scheduler to finish loading (the main thread must not run before the process is registered)
 	 ------------------------------------------------------*/
-	os_scheduler_stop();
+	os_scheduler_lock();
+	schLocked = true;
 
 	/* Create main thread
 	 ------------------------------------------------------*/
 	os_handle_t t;
-	ret = os_task_createProc(&t, NULL, new_proc->entry_fn, new_proc, OS_TASK_MODE_DELETE, 40, OS_DEFAULT_STACK_SIZE, argc, argv, new_proc->gotBaseAddr);
+	ret = os_task_createProc(&t, NULL, new_proc->entry_fn, new_proc, OS_TASK_MODE_DELETE, params.priority, params.stackSize, argc, args, new_proc->gotBaseAddr);
 	if(ret != OS_ERR_OK) {
 		PRINTLN("Error creating main task");
 		goto exit_file;
@@ -402,8 +1691,17 @@ os_err_e os_process_create(char* file, int argc, char* argv[]){
 		PRINTLN("Close Error");
 	}
 
-	sch == OS_SCHEDULER_STOP ? os_scheduler_stop() : os_scheduler_start();
+	os_scheduler_unlock();
+	os_mutex_release(fsMutex);
+
+	/* The process runs on its own copy of the arguments
+	 ------------------------------------------------------*/
+	for(int i = 0; i < argc && argv != NULL; i++)
+		os_heap_free(argv[i]);
+
+	os_heap_free(argv);
 
+	*pid = new_proc->PID;
 	return OS_ERR_OK;
 
 	/* Cleanup in case of error
@@ -434,18 +1732,279 @@ exit:
 	if(new_proc->p_name != NULL)
 		os_heap_free(new_proc->p_name);
 
-	if(new_proc->segments != NULL)
-		os_heap_free(new_proc->segments);
+	if(new_proc->arena != NULL)
+		os_heap_arenaDelete(new_proc->arena);
+
+	os_elf_textRelease(new_proc);
 
 	if(new_proc != NULL)
 		os_heap_free(new_proc);
 
-	sch == OS_SCHEDULER_STOP ? os_scheduler_stop() : os_scheduler_start();
+	if(schLocked) os_scheduler_unlock();
+	if(fsLocked) os_mutex_release(fsMutex);
+
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS Process load job
+ *
+ * @brief This function creates the process of a job queued by os_process_createAsync. It runs on the loader task
+ *
+ * @param void* arg : [in] The job
+ **********************************************************************/
+static void os_process_loadJob(void* arg){
+
+	os_process_job_t* job = (os_process_job_t*)arg;
+
+	job->ret = os_process_load(job->file, job->argc, job->argv, &job->PID);
+
+	if(job->done != NULL)
+		job->done(job);
+
+	os_heap_free(job);
+}
+
+
+/**********************************************
+ * OS PUBLIC FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Process get by PID
+ *
+ * @brief This function searches for a process with a giben PID
+ *
+ * @param uint16_t pid : [in] PID to search
+ *
+ * @return os_process_t* : reference to found process
+ *
+ **********************************************************************/
+os_process_t* os_process_getByPID(uint16_t pid){
+	if(pid == 0) return NULL;
+
+	os_list_cell_t* it = os_process_list.head.next;
+	while(it != NULL){
+		if( ((os_process_t*)it->element)->PID == pid )
+			return it->element;
+
+		it = it->next;
+	}
+
+	return NULL;
+}
+
+
+/***********************************************************************
+ * OS Create process
+ *
+ * @brief This function creates a process using its ELF file or its packed image (see Tools/os_pack). The process allocates everything
+ * in its own arena of the heap, freed at once when the process is killed.
+ *
+ * @param char* file   : [in] File's name
+ * @param void* argc   : [in] Argument number to be passed to the task
+ * @param char* argv[] : [in] Array of heap allocated strings to be passed to the task. Freed on success (the process runs on a copy)
+ *
+ * @return os_err_e : An error code (0 = OK)
+ *
+ **********************************************************************/
+os_err_e os_process_create(char* file, int argc, char* argv[]){
+	uint16_t pid = 0;
+
+	return os_process_load(file, argc, argv, &pid);
+}
+
+
+/***********************************************************************
+ * OS Create process asynchronously
+ *
+ * @brief This function queues the creation of a process on the loader task (OS_PROCESS_LOADER_PRIO), and returns immediately.
+ * On success, argv is freed (the process runs on a copy in its arena). On error, it is given back through the job passed to done.
+ *
+ * @param char* file   						: [in] File's name (copied)
+ * @param void* argc   						: [in] Argument number to be passed to the task
+ * @param char* argv[] 						: [in] Array of strings to be passed to the task
+ * @param void (*done)(os_process_job_t*) 	: [in] Function called by the loader task once the process is created or failed. NULL if none
+ * @param void* arg 						: [in] Argument stored in the job passed to done
+ * @param os_handle_t doneEvt 				: [in] Event set once the job is over (after done returned). NULL if none
+ *
+ * @return os_err_e : An error code (0 = OK) about queuing the job. The creation result is given to done
+ *
+ **********************************************************************/
+os_err_e os_process_createAsync(char* file, int argc, char* argv[], void (*done)(os_process_job_t*), void* arg, os_handle_t doneEvt){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(file == NULL) return OS_ERR_BAD_ARG;
+
+	/* Create the loader on first use. Critical so two callers cannot both create it
+	 ------------------------------------------------------*/
+	os_err_e qErr = OS_ERR_OK;
+	OS_CRITICAL_SECTION(
+		if(os_process_loaderWorkQ == NULL)
+			qErr = os_workq_create(&os_process_loaderWorkQ, 1, OS_PROCESS_LOADER_PRIO, OS_PROCESS_LOADER_STACK_SIZE, "proc loader");
+	);
+	if(qErr != OS_ERR_OK) return qErr;
+
+	/* Alloc the job and the copy of the name in one block
+	 ------------------------------------------------------*/
+	os_process_job_t* job = (os_process_job_t*)os_heap_alloc(sizeof(os_process_job_t) + strlen(file) + 1);
+	if(job == NULL) return OS_ERR_INSUFFICIENT_HEAP;
+
+	job->file 	= (char*)&job[1];
+	job->argc 	= argc;
+	job->argv 	= argv;
+	job->ret 	= OS_ERR_NOT_READY;
+	job->PID 	= 0;
+	job->done 	= done;
+	job->arg 	= arg;
+	strcpy(job->file, file);
+
+	/* Queue it
+	 ------------------------------------------------------*/
+	os_err_e err = os_workq_submit(os_process_loaderWorkQ, os_process_loadJob, job, doneEvt);
+	if(err != OS_ERR_OK)
+		os_heap_free(job);
+
+	return err;
+}
+
+
+/***********************************************************************
+ * OS Install process
+ *
+ * @brief This function copies the text of an ELF file to the installed image area, so that the next processes created
+ * from this file execute it in place and only load their writable data into RAM. The program must have a single read only
+ * LOAD segment, no relocation may patch it, and its code must reach data through the GOT (R9) only.
+ * Installing the file again after modifying it replaces the old image. The FS mutex is held during the whole install,
+ * lfs and the installed image area share the flash driver.
+ *
+ * @param char* file : [in] File's name
+ *
+ * @return os_err_e : An error code (0 = OK). OS_ERR_INVALID if the program cannot execute in place or there is no room left
+ *
+ **********************************************************************/
+os_err_e os_process_install(char* file){
+
+	/* Check arguments
+	 --------------------------------------------------*/
+	if(file == NULL || strlen(file) >= OS_XIP_NAME_LEN) return OS_ERR_BAD_ARG;
+
+	os_process_t proc;
+	memset(&proc, 0, sizeof(proc));
+	proc.p_name = file;
+
+	os_elf_ctx_t ctx = { 0 };
+
+	/* Get FS mutex
+	 --------------------------------------------------*/
+	os_err_e ret = OS_ERR_OK;
+	os_obj_single_wait(fsMutex, OS_WAIT_FOREVER, &ret);
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	/* Open file
+	 --------------------------------------------------*/
+	lfs_file_t lfs_file;
+	int err = lfs_file_open(&lfs, &lfs_file, file, LFS_O_RDONLY);
+	if(err < 0){
+		PRINTLN("Open Error");
+		os_mutex_release(fsMutex);
+		return OS_ERR_FS;
+	}
+
+	/* Load header and tables
+	 --------------------------------------------------*/
+	ret = os_elf_loadHeader(&proc.elf_H, &lfs_file);
+	if(ret == OS_ERR_OK)
+		ret = os_elf_loadTables(&proc, &lfs_file, &ctx);
+
+	/* Check the text can be executed in place
+	 --------------------------------------------------*/
+	os_elf_programHeader_t* text = NULL;
+	if(ret == OS_ERR_OK){
+		text = os_elf_textSegment(&proc, &ctx);
+		ret = text == NULL ? OS_ERR_INVALID : os_elf_checkInPlace(&proc, &lfs_file, &ctx, text);
+	}
+
+	/* Install it
+	 --------------------------------------------------*/
+	if(ret == OS_ERR_OK)
+		ret = os_elf_installText(&proc, &lfs_file, &ctx, text);
+
+	os_elf_freeTables(&ctx);
+
+	if(lfs_file_close(&lfs, &lfs_file) < 0){
+		PRINTLN("Close Error");
+	}
+
+	os_mutex_release(fsMutex);
 
 	return ret;
 }
 
 
+/***********************************************************************
+ * OS Process set limits
+ *
+ * @brief This function changes the limits of a process. Memory already allocated and threads already running are kept,
+ * only the next requests are checked against the new limits. A new CPU share applies from the next accounting window
+ *
+ * @param os_process_t* proc 				: [in] Process reference
+ * @param os_process_limits_t const* limits : [in] New limits
+ *
+ * @return os_err_e : An error code (0 = OK)
+ **********************************************************************/
+os_err_e os_process_setLimits(os_process_t* proc, os_process_limits_t const* limits){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(proc == NULL || limits == NULL) 						return OS_ERR_BAD_ARG;
+	if(limits->cpuShare == 0 || limits->cpuShare > 100) 	return OS_ERR_BAD_ARG;
+	if(limits->maxThreads == 0) 							return OS_ERR_BAD_ARG;
+
+	OS_CRITICAL_SECTION(
+		proc->limits = *limits;
+	);
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Process get usage
+ *
+ * @brief This function takes a snapshot of the resources used by a process
+ *
+ * @param os_process_t* proc 		: [ in] Process reference
+ * @param os_process_usage_t* usage : [out] Resource usage
+ *
+ * @return os_err_e : An error code (0 = OK)
+ **********************************************************************/
+os_err_e os_process_getUsage(os_process_t* proc, os_process_usage_t* usage){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(proc == NULL || usage == NULL) return OS_ERR_BAD_ARG;
+
+	/* Copy the counters and sum the stacks of the threads
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		*usage = proc->usage;
+		usage->threads = 0;
+		usage->stackBytes = 0;
+
+		for(os_list_cell_t* it = ((os_list_head_t*)proc->thread_list)->head.next; it != NULL; it = it->next){
+			usage->threads++;
+			usage->stackBytes += ((os_task_t*)it->element)->stackSize;
+		}
+	);
+
+	return OS_ERR_OK;
+}
+
+
 /***********************************************************************
  * Kill a process
  *
@@ -462,18 +2021,26 @@ os_err_e os_process_kill(os_process_t* proc){
 	if(ret != OS_ERR_OK)
 		return ret;
 
-	os_list_cell_t* it = ((os_list_head_t*)proc->thread_list)->head.next;
-	while(it != NULL){
-		ret = os_task_delete(it->element);
+	/* Detach and delete threads (their stacks and arguments are in the arena)
+	 ------------------------------------------------------*/
+	os_list_cell_t* it;
+	while((it = ((os_list_head_t*)proc->thread_list)->head.next) != NULL){
+		os_task_t* t = (os_task_t*)it->element;
+
+		os_list_remove(proc->thread_list, t);
+		t->process = NULL;
+
+		ret = os_task_delete((os_handle_t)t);
 		if(ret != OS_ERR_OK)
 			return ret;
-
-		it = it->next;
 	}
 
 	os_list_clear(proc->thread_list);
 
-	os_heap_free(proc->segments);
+	/* Everything the process allocated goes away with its arena
+	 ------------------------------------------------------*/
+	os_heap_arenaDelete(proc->arena);
+	os_elf_textRelease(proc);
 	os_heap_free(proc->p_name);
 	os_heap_free(proc);
 
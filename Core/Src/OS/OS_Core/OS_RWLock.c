@@ -0,0 +1,393 @@
+/*
+ * OS_RWLock.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_obj_head;	//Head to obj list
+extern os_list_cell_t* os_cur_task;	//Current task pointer
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS RW Lock get free count
+ *
+ * @brief Gets whether the lock can be taken by a given task, using the access mode the task asked for.
+ * Readers are refused as soon as a writer waits. Writers are refused if a higher priority writer waits, or a writer of the
+ * same priority placed before them in the block list, so that a release wakes exactly one writer.
+ *
+ * @param os_handle_t h 			: [in] object to verify the availability
+ * @param os_handle_t takingTask	: [in] task that would take the lock (NULL is considered a reader)
+ *
+ * @return uint32_t : 1 if the lock can be taken, 0 otherwise
+ *
+ **********************************************************************/
+static uint32_t os_rwlock_getFreeCount(os_handle_t h, os_handle_t takingTask){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_rwlock_t* rw = os_rwlock_getFromHandle(h);
+	if(rw == NULL) return 0;
+
+	/* Nobody gets in while a writer holds the lock
+	 ------------------------------------------------------*/
+	if(rw->writer != NULL) return 0;
+
+	/* A writer also needs the readers to be gone
+	 ------------------------------------------------------*/
+	os_task_t* t = (os_task_t*)takingTask;
+	bool write = t != NULL && t->rwMode == OS_RWLOCK_MODE_WRITE;
+	if(write && rw->readers > 0) return 0;
+
+	/* Scan the waiting writers
+	 ------------------------------------------------------*/
+	bool before = true;
+	for(os_list_cell_t* it = ((os_list_head_t*)h->blockList)->head.next; it != NULL; it = it->next){
+		os_task_t* w = (os_task_t*)it->element;
+
+		/* Only consider other live writers
+		 ------------------------------------------------------*/
+		if(w == t){
+			before = false;
+			continue;
+		}
+
+		if(w->rwMode != OS_RWLOCK_MODE_WRITE) continue;
+		if(w->state == OS_TASK_DELETING || w->state == OS_TASK_ENDED) continue;
+
+		/* Writer preference, and the highest priority writer goes first. Ties go to the first one of the list
+		 ------------------------------------------------------*/
+		if(write == false || w->priority > t->priority) return 0;
+		if(before && w->priority == t->priority) return 0;
+	}
+
+	return 1;
+}
+
+
+/***********************************************************************
+ * OS RW Lock take
+ *
+ * @brief This function takes the lock with the access mode the task asked for.
+ *
+ * @param os_handle_t h 			: [in] object to take
+ * @param os_handle_t takingTask	: [in] handle to the task that is taking the object
+ *
+ * @return os_err_e : 0 if ok
+ **********************************************************************/
+static os_err_e os_rwlock_objTake(os_handle_t h, os_handle_t takingTask){
+
+	/* Convert address
+	 ------------------------------------------------------*/
+	os_task_t* t	= (os_task_t*)takingTask;
+	os_rwlock_t* rw = os_rwlock_getFromHandle(h);
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(rw == NULL) return OS_ERR_BAD_ARG;
+	if(rw->writer != NULL) return OS_ERR_BAD_ARG;
+
+	if(takingTask == NULL) return OS_ERR_BAD_ARG;
+	if(takingTask->type != OS_OBJ_TASK) return OS_ERR_BAD_ARG;
+
+	/* Readers only count themselves
+	 ------------------------------------------------------*/
+	if(t->rwMode != OS_RWLOCK_MODE_WRITE){
+		rw->readers++;
+		return OS_ERR_OK;
+	}
+
+	if(rw->readers > 0) return OS_ERR_BAD_ARG;
+
+	/* Store writer and add the lock to its owned list so it inherits the waiters' priority
+	 ------------------------------------------------------*/
+	rw->writer = takingTask;
+
+	os_err_e ret = os_list_add(t->ownedMutex, h, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) rw->writer = NULL;
+
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS RW Lock lock
+ *
+ * @brief This function waits for the lock with the given access mode
+ *
+ * @param os_handle_t h 			: [ in] Handle to the lock
+ * @param os_rwlock_mode_e mode 	: [ in] Access wanted
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+static os_err_e os_rwlock_lock(os_handle_t h, os_rwlock_mode_e mode, uint32_t timeout_ticks){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(os_rwlock_getFromHandle(h) == NULL) return OS_ERR_BAD_ARG;
+
+	/* The access mode is stored on the running task, so interrupts cannot use the lock
+	 ------------------------------------------------------*/
+	uint32_t ipsr;
+	__asm volatile("mrs %[out], ipsr" : [out] "=r" (ipsr));
+	if(ipsr != 0) return OS_ERR_FORBIDDEN;
+
+	/* Wait with the access mode set, then go back to the default one
+	 ------------------------------------------------------*/
+	os_task_t* t = (os_task_t*)os_cur_task->element;
+	os_err_e err = OS_ERR_OK;
+
+	t->rwMode = mode;
+	os_obj_single_wait(h, timeout_ticks, &err);
+	t->rwMode = OS_RWLOCK_MODE_READ;
+
+	return err;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS RW Lock Create
+ *
+ * @brief This function creates a reader-writer lock. Any number of readers can hold it at the same time, a writer holds it alone.
+ * Once a writer waits, new readers are blocked (writer preference), and the writer inherits the priority of the tasks waiting for it.
+ *
+ * @param os_handle_t* h 	: [out] handle to the lock
+ * @param char* name		: [ in] lock name. If a lock with the same name already exists, its reference is returned. A null name always creates a nameless lock.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_rwlock_create(os_handle_t* h, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(h == NULL) 							return OS_ERR_BAD_ARG;
+	if(os_init_get() == false)				return OS_ERR_NOT_READY;
+
+	/* If lock exists, return it
+	 ------------------------------------------------------*/
+	if(name != NULL){
+		os_list_cell_t* obj = os_handle_list_searchByName(&os_obj_head, OS_OBJ_RWLOCK, name);
+		if(obj != NULL){
+			*h = obj->element;
+			return OS_ERR_OK;
+		}
+	}
+
+	/* Alloc the lock block
+	 ------------------------------------------------------*/
+	os_rwlock_t* rw = (os_rwlock_t*)os_heap_alloc(sizeof(os_rwlock_t));
+
+	/* Check allocation
+	 ------------------------------------------------------*/
+	if(rw == 0) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init lock
+	 ------------------------------------------------------*/
+	rw->obj.type 			= OS_OBJ_RWLOCK;
+	rw->obj.objUpdate 		= 0;
+	rw->obj.getFreeCount	= os_rwlock_getFreeCount;
+	rw->obj.obj_take 		= os_rwlock_objTake;
+	rw->obj.blockList		= os_list_init();
+	rw->obj.waitSet			= NULL;
+	rw->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
+
+	/* Finish init
+	 ------------------------------------------------------*/
+	rw->writer				= NULL;
+	rw->readers				= 0;
+	rw->max_prio			= -1;
+
+	/* Handles heap errors
+	 ------------------------------------------------------*/
+	if(rw->obj.blockList == NULL || (rw->obj.name == NULL && name != NULL) ){
+		os_list_clear(rw->obj.blockList);
+		os_heap_free(rw->obj.name);
+		os_heap_free(rw);
+
+		return OS_ERR_INSUFFICIENT_HEAP;
+	}
+
+	/* Copy name
+	 ------------------------------------------------------*/
+	if(name != NULL)
+		strcpy(rw->obj.name, name);
+
+	/* Add object to object list
+	 ------------------------------------------------------*/
+	os_err_e ret = os_list_add(&os_obj_head, (os_handle_t) rw, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) {
+		os_list_clear(rw->obj.blockList);
+		os_heap_free(rw->obj.name);
+		os_heap_free(rw);
+
+		return ret;
+	}
+
+	/* Return
+	 ------------------------------------------------------*/
+	*h = (os_handle_t)rw;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS RW Lock Read Lock
+ *
+ * @brief This function takes the lock for reading. Waiting for the lock through os_obj_wait functions also takes it for reading.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the lock
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_TIMEOUT if the lock could not be taken in time
+ **********************************************************************/
+os_err_e os_rwlock_readLock(os_handle_t h, uint32_t timeout_ticks){
+	return os_rwlock_lock(h, OS_RWLOCK_MODE_READ, timeout_ticks);
+}
+
+
+/***********************************************************************
+ * OS RW Lock Write Lock
+ *
+ * @brief This function takes the lock for writing. The lock cannot be taken while it is held by anyone else.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the lock
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_TIMEOUT if the lock could not be taken in time
+ **********************************************************************/
+os_err_e os_rwlock_writeLock(os_handle_t h, uint32_t timeout_ticks){
+	return os_rwlock_lock(h, OS_RWLOCK_MODE_WRITE, timeout_ticks);
+}
+
+
+/***********************************************************************
+ * OS RW Lock Read Unlock
+ *
+ * @brief This function releases one read access
+ *
+ * @param os_handle_t h : [ in] Handle to the lock
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_FORBIDDEN if the lock is not held for reading
+ **********************************************************************/
+os_err_e os_rwlock_readUnlock(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_rwlock_t* rw = os_rwlock_getFromHandle(h);
+	if(rw == NULL) return OS_ERR_BAD_ARG;
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	if(rw->readers == 0){
+		OS_EXIT_CRITICAL();
+		return OS_ERR_FORBIDDEN;
+	}
+
+	/* Only the last reader leaving can wake someone up
+	 ------------------------------------------------------*/
+	rw->readers--;
+
+	bool must_yield = rw->readers == 0 ? os_handle_list_updateAndCheck(h) : false;
+
+	/* Yield if necessary
+	 ------------------------------------------------------*/
+	if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+
+	OS_EXIT_CRITICAL();
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS RW Lock Write Unlock
+ *
+ * @brief This function releases the write access. Must be called by the writer.
+ *
+ * @param os_handle_t h : [ in] Handle to the lock
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_FORBIDDEN if the current task is not the writer
+ **********************************************************************/
+os_err_e os_rwlock_writeUnlock(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_rwlock_t* rw = os_rwlock_getFromHandle(h);
+	if(rw == NULL) return OS_ERR_BAD_ARG;
+	if(rw->writer == NULL) return OS_ERR_FORBIDDEN;
+	if(rw->writer != os_cur_task->element) return OS_ERR_FORBIDDEN;
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+
+		/* Remove lock from owned list and give back the inherited priority
+		 ------------------------------------------------------*/
+		os_handle_t owner = rw->writer;
+		os_list_remove( ((os_task_t*)owner)->ownedMutex, h);
+
+		rw->writer = NULL;
+		os_obj_updatePrio(owner);
+
+		/* Update blocking list and check if we must yield
+		 ------------------------------------------------------*/
+		bool must_yield = os_handle_list_updateAndCheck(h);
+
+		/* Yield if necessary
+		 ------------------------------------------------------*/
+		if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+	);
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS RW Lock delete
+ *
+ * @brief This function deletes a reader-writer lock. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the lock
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_rwlock_delete(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_rwlock_t* rw = os_rwlock_getFromHandle(h);
+	if(rw == NULL) return OS_ERR_BAD_ARG;
+
+	/* Deletes from obj list, from its wait-set and from the writer's owned list
+	 ------------------------------------------------------*/
+	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
+
+	if(rw->writer != NULL)
+		os_list_remove( ((os_task_t*)rw->writer)->ownedMutex, h);
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	os_list_clear(h->blockList);
+	os_heap_free(h->name);
+
+	return os_heap_free(h);
+}
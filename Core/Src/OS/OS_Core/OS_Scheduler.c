@@ -26,6 +26,8 @@ extern os_list_head_t  os_head;		//Pointer to task list
  *********************************************/
 
 static os_scheduler_state_e state = OS_SCHEDULER_STOP; //Current state of the scheduler
+static uint32_t lockCount = 0;						 //Nesting level of os_scheduler_lock
+static bool switchDeferred = false;					 //A context switch was requested while the scheduler was locked
 
 /**********************************************
  * PRIVATE FUNCTIONS
@@ -123,6 +125,42 @@ static os_list_cell_t* os_round_robin(){
 	return ( (lowSidePrio > highSidePrio) ? lowSide : highSide);
 }
 
+#if defined(__OS_CORTEX_M4) && OS_STACK_GUARD_EN == 1
+/***********************************************************************
+ * OS Scheduler guard base
+ *
+ * @brief This function computes the base of the stack guard of a task : the first address aligned on the guard size inside its stack
+ *
+ * @param os_task_t const* t : [in] Task
+ *
+ * @return uint32_t : Base address of the guard, 0 if the task has no stack of its own (main task)
+ **********************************************************************/
+static inline uint32_t os_scheduler_guardBase(os_task_t const* t){
+	if(t->stackSize == 0) return 0;
+
+	return (t->stackBase - t->stackSize + OS_STACK_GUARD_SIZE - 1) & ~(uint32_t)(OS_STACK_GUARD_SIZE - 1);
+}
+
+
+/***********************************************************************
+ * OS Scheduler set guard
+ *
+ * @brief This function moves the stack guard region to the bottom of the stack of the task about to run
+ *
+ * @param os_task_t const* t : [in] Task about to run
+ **********************************************************************/
+static void os_scheduler_setGuard(os_task_t const* t){
+	uint32_t guard = os_scheduler_guardBase(t);
+
+	OS_MPU->RNR  = OS_MPU_STACK_GUARD_REGION;
+	OS_MPU->RASR = 0;		//Disabled while it moves
+	OS_MPU->RBAR = guard;
+	OS_MPU->RASR = guard == 0 ? 0 : OS_MPU_STACK_GUARD_RASR;
+
+	__asm volatile("dsb\n isb" ::: "memory");
+}
+#endif
+
 /***********************************************************************
  * OS Scheduler
  *
@@ -135,6 +173,13 @@ __used static void os_scheduler(){
 	 ------------------------------------------------------*/
 	if(state != OS_SCHEDULER_START) return;
 
+	/* While locked, keep the current task and remember to switch on unlock
+	 ------------------------------------------------------*/
+	if(lockCount > 0) {
+		switchDeferred = true;
+		return;
+	}
+
 	/* Enter Critical -> If the list is changed during the process, this can corrupt our references
 	 ------------------------------------------------------*/
 	__os_disable_irq();
@@ -147,10 +192,6 @@ __used static void os_scheduler(){
 	if(os_cur_task != NULL)
 		((os_task_t*)os_cur_task->element)->pStack = (uint32_t*)psp;
 
-	/* Save last task
-	 ------------------------------------------------------*/
-	os_list_cell_t* last_task = os_cur_task;
-
 	/* Loop here until a task can be executed
 	 ------------------------------------------------------*/
 	do {
@@ -169,6 +210,10 @@ __used static void os_scheduler(){
 
 	}while(os_cur_task == NULL);
 
+	/* Publish the new task to processes
+	 ------------------------------------------------------*/
+	os_kdata_setTask(os_cur_task->element);
+
 #ifdef __OS_CORTEX_M33
 	/* Put PSPLIM to the minimum of the last and current task  
 	 ------------------------------------------------------*/
@@ -179,6 +224,12 @@ __used static void os_scheduler(){
 	__asm volatile ("msr psplim, %[in]" : : [in] "r" (min_psplim));
 #endif
 
+#if defined(__OS_CORTEX_M4) && OS_STACK_GUARD_EN == 1
+	/* Guard the bottom of the new task stack
+	 ------------------------------------------------------*/
+	os_scheduler_setGuard((os_task_t*)os_cur_task->element);
+#endif
+
 	/* Write task stack location into current stack
 	 ------------------------------------------------------*/
 	psp = (uint32_t) ((os_task_t*)os_cur_task->element)->pStack;
@@ -190,10 +241,6 @@ __used static void os_scheduler(){
 	__asm volatile ("msr psplim, %[in]" : : [in] "r" (new_psplim));
 #endif
 
-	/* If last task is deleting state, remove it
-	 ------------------------------------------------------*/
-	if(last_task != NULL && ((os_task_t*)last_task->element)->state == OS_TASK_DELETING) os_task_delete((os_handle_t)last_task->element);
-
 	/* Enable IRQ
 	 ------------------------------------------------------*/
 	__os_enable_irq();
@@ -315,6 +362,67 @@ os_err_e os_scheduler_stop(){
 }
 
 
+/***********************************************************************
+ * OS Scheduler lock
+ *
+ * @brief Prevents context switches without disabling interrupts. Calls can be nested.
+ * The running task must not block, sleep or end while the scheduler is locked.
+ *
+ **********************************************************************/
+void os_scheduler_lock(){
+	OS_CRITICAL_SECTION(
+		lockCount++;
+	);
+}
+
+
+/***********************************************************************
+ * OS Scheduler unlock
+ *
+ * @brief Undoes one os_scheduler_lock. The last unlock runs any context switch requested meanwhile.
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_FORBIDDEN if the scheduler was not locked
+ *
+ **********************************************************************/
+os_err_e os_scheduler_unlock(){
+
+	/* Enter critical to avoid being interrupted in the middle of the update
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	if(lockCount == 0){
+		OS_EXIT_CRITICAL();
+		return OS_ERR_FORBIDDEN;
+	}
+
+	/* Run the deferred switch on the last unlock
+	 ------------------------------------------------------*/
+	lockCount--;
+	if(lockCount == 0 && switchDeferred){
+		switchDeferred = false;
+		OS_SET_PENDSV();
+	}
+
+	OS_EXIT_CRITICAL();
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Scheduler is locked
+ *
+ * @brief Returns whether context switches are currently deferred by os_scheduler_lock
+ *
+ * @return bool : 1 = locked; 0 = unlocked
+ *
+ **********************************************************************/
+bool os_scheduler_isLocked(){
+	return lockCount > 0;
+}
+
+
 /***********************************************************************
  * OS Scheduler State get
  *
@@ -326,3 +434,35 @@ os_err_e os_scheduler_stop(){
 os_scheduler_state_e os_scheduler_state_get(){
 	return state;
 }
+
+
+/***********************************************************************
+ * OS Scheduler Stack Fault
+ *
+ * @brief This function checks if the memory fault being handled was caused by the running task reaching its stack guard, and calls
+ * os_stack_overflow_cb if so. To be called by the MemManage and HardFault handlers (faults in critical sections are escalated)
+ *
+ **********************************************************************/
+void os_scheduler_stackFault(){
+#if defined(__OS_CORTEX_M4) && OS_STACK_GUARD_EN == 1
+
+	if(os_cur_task == NULL) return;
+
+	os_task_t* t = (os_task_t*)os_cur_task->element;
+	uint32_t guard = os_scheduler_guardBase(t);
+	if(guard == 0) return;
+
+	/* Access to the guard, or exception frame pushed into it (PSP may not account for the frame that failed)
+	 ------------------------------------------------------*/
+	register uint32_t volatile psp = 0;
+	__asm volatile ("mrs %[out], psp" : [out] "=r" (psp));
+
+	uint32_t cfsr = OS_SYSTEM_CTRL->CFSR;
+	uint32_t addr = OS_SYSTEM_CTRL->MMFAR;
+
+	bool overflow  = (cfsr & OS_SYSTEM_CTRL_CFSR_MMARVALID) != 0 && guard <= addr && addr < guard + OS_STACK_GUARD_SIZE;
+		 overflow |= (cfsr & OS_SYSTEM_CTRL_CFSR_MSTKERR) != 0 && psp < guard + OS_STACK_GUARD_SIZE + OS_EXC_FRAME_MAX_SIZE;
+
+	if(overflow) os_stack_overflow_cb((os_handle_t)t);
+#endif
+}
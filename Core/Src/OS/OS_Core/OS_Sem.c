@@ -69,6 +69,37 @@ static os_err_e os_sem_objTake(os_handle_t h, os_handle_t takingTask){
 }
 
 
+/**********************************************
+ * OS PRIVATE FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Semaphore fast take
+ *
+ * @brief This function decrements a semaphore nobody is waiting for without going through the generic wait.
+ *
+ * @param os_handle_t h : [in] semaphore to take
+ *
+ * @return bool : 1 = semaphore taken; 0 = the slow path must be used
+ **********************************************************************/
+bool os_sem_fastTake(os_handle_t h){
+
+	os_sem_t* sem = (os_sem_t*)h;
+	bool taken = false;
+
+	/* Only take it if available, uncontended and not watched by a wait-set
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		if(sem->count > 0 && ((os_list_head_t*)h->blockList)->listSize == 0 && h->waitSet == NULL){
+			sem->count--;
+			taken = true;
+		}
+	);
+
+	return taken;
+}
+
 /**********************************************
  * PUBLIC FUNCTIONS
  *********************************************/
@@ -119,6 +150,7 @@ os_err_e os_sem_create(os_handle_t* h, uint16_t init_count, uint16_t max_count,
 	sem->obj.getFreeCount	= &os_sem_getFreeCount;
 	sem->obj.obj_take		= &os_sem_objTake;
 	sem->obj.blockList		= os_list_init();
+	sem->obj.waitSet		= NULL;
 	sem->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
 
 	/* Finish init
@@ -189,6 +221,13 @@ os_err_e os_sem_release(os_handle_t h, uint16_t amount){
 	 ------------------------------------------------------*/
 	sem->count = (uint16_t)(sem->count + amount);
 
+	/* Fast path: nobody to wake up
+	 ------------------------------------------------------*/
+	if(((os_list_head_t*)h->blockList)->listSize == 0 && h->waitSet == NULL){
+		OS_EXIT_CRITICAL();
+		return OS_ERR_OK;
+	}
+
 	/* Update blocking list and check if we must yield
 	 ------------------------------------------------------*/
 	bool must_yield = os_handle_list_updateAndCheck( (os_handle_t)sem );
@@ -219,9 +258,10 @@ os_err_e os_sem_delete(os_handle_t h){
 	if(h == NULL) return OS_ERR_BAD_ARG;
 	if(h->type != OS_OBJ_SEM) return OS_ERR_BAD_ARG;
 
-	/* Deletes from obj list
+	/* Deletes from obj list and from its wait-set
 	 ------------------------------------------------------*/
 	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
 
 	/* Free memory
 	 ------------------------------------------------------*/
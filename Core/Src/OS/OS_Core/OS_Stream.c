@@ -0,0 +1,361 @@
+/*
+ * OS_Stream.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_obj_head;	//Head to obj list
+extern os_list_cell_t* os_cur_task;	//Current task pointer
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Stream get free count
+ *
+ * @brief Gets the amount of times the stream can be read before blocking
+ *
+ * @param os_handle_t h : [in] object to verify the availability
+ *
+ * @return uint32_t : the amount of times the object can be taken
+ *
+ **********************************************************************/
+static uint32_t os_stream_getFreeCount(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(takingTask);
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_stream_t* s = os_stream_getFromHandle(h);
+	if(s == NULL) return 0;
+
+	return s->count >= s->trigger ? 1 : 0;
+}
+
+
+/***********************************************************************
+ * OS Stream take
+ *
+ * @brief Unused. The bytes are consumed by os_stream_read
+ *
+ * @param os_handle_t h 			: [in] object to take
+ * @param os_handle_t takingTask	: [in] handle to the task that is taking the object
+ *
+ * @return os_err_e : 0 if OK
+ **********************************************************************/
+static os_err_e os_stream_objTake(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(h);
+	UNUSED_ARG(takingTask);
+
+	return OS_ERR_OK;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Stream Create
+ *
+ * @brief This function creates a byte stream buffer. Waiting for a stream returns once at least trigger bytes are available.
+ *
+ * @param os_handle_t* h 	: [out] handle to stream
+ * @param size_t size 		: [ in] size of the buffer in bytes
+ * @param size_t trigger 	: [ in] number of bytes that wakes a reader (1 to size)
+ * @param char* name		: [ in] stream name. If a stream with the same name already exists, its reference is returned. A null name always creates a nameless stream.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_stream_create(os_handle_t* h, size_t size, size_t trigger, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(h == NULL) 							return OS_ERR_BAD_ARG;
+	if(size == 0) 							return OS_ERR_BAD_ARG;
+	if(trigger == 0 || trigger > size) 		return OS_ERR_BAD_ARG;
+	if(os_init_get() == false)				return OS_ERR_NOT_READY;
+
+	/* If stream exists, return it
+	 ------------------------------------------------------*/
+	if(name != NULL){
+		os_list_cell_t* obj = os_handle_list_searchByName(&os_obj_head, OS_OBJ_STREAM, name);
+		if(obj != NULL){
+			*h = obj->element;
+			return OS_ERR_OK;
+		}
+	}
+
+	/* Alloc the stream block
+	 ------------------------------------------------------*/
+	os_stream_t* s = (os_stream_t*)os_heap_alloc(sizeof(os_stream_t));
+
+	/* Check allocation
+	 ------------------------------------------------------*/
+	if(s == 0) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init stream
+	 ------------------------------------------------------*/
+	s->obj.type 			= OS_OBJ_STREAM;
+	s->obj.objUpdate 		= 0;
+	s->obj.getFreeCount		= os_stream_getFreeCount;
+	s->obj.obj_take 		= os_stream_objTake;
+	s->obj.blockList		= os_list_init();
+	s->obj.waitSet			= NULL;
+	s->obj.name				= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
+
+	/* Finish init
+	 ------------------------------------------------------*/
+	s->buf					= (uint8_t*)os_heap_alloc(size);
+	s->size					= size;
+	s->head					= 0;
+	s->tail					= 0;
+	s->count				= 0;
+	s->trigger				= trigger;
+
+	/* Handles heap errors
+	 ------------------------------------------------------*/
+	if(s->obj.blockList == NULL || s->buf == NULL || (s->obj.name == NULL && name != NULL) ){
+		os_list_clear(s->obj.blockList);
+		os_heap_free(s->buf);
+		os_heap_free(s->obj.name);
+		os_heap_free(s);
+
+		return OS_ERR_INSUFFICIENT_HEAP;
+	}
+
+	/* Copy name
+	 ------------------------------------------------------*/
+	if(name != NULL)
+		strcpy(s->obj.name, name);
+
+	/* Add object to object list
+	 ------------------------------------------------------*/
+	os_err_e ret = os_list_add(&os_obj_head, (os_handle_t) s, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) {
+		os_list_clear(s->obj.blockList);
+		os_heap_free(s->buf);
+		os_heap_free(s->obj.name);
+		os_heap_free(s);
+
+		return ret;
+	}
+
+	/* Return
+	 ------------------------------------------------------*/
+	*h = (os_handle_t)s;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Stream Write
+ *
+ * @brief This function copies bytes into the stream. Bytes that do not fit are dropped. Never blocks nor allocates, so it can be called from interrupts.
+ *
+ * @param os_handle_t h 	: [ in] Handle to the stream
+ * @param void const* data 	: [ in] Bytes to write
+ * @param size_t len 		: [ in] Number of bytes to write
+ *
+ * @return size_t : number of bytes actually written
+ **********************************************************************/
+size_t os_stream_write(os_handle_t h, void const* data, size_t len){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_stream_t* s = os_stream_getFromHandle(h);
+	if(s == NULL || data == NULL) return 0;
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Clamp to the free space
+	 ------------------------------------------------------*/
+	size_t freeSpace = s->size - s->count;
+	len = len > freeSpace ? freeSpace : len;
+
+	/* Copy in up to two chunks (end of buffer, then beginning)
+	 ------------------------------------------------------*/
+	size_t first = s->size - s->head;
+	first = first > len ? len : first;
+
+	memcpy(&s->buf[s->head], data, first);
+	memcpy(&s->buf[0], (uint8_t const*)data + first, len - first);
+
+	s->head = (s->head + len) % s->size;
+
+	/* Only crossing the trigger level can wake the reader
+	 ------------------------------------------------------*/
+	bool crossed = s->count < s->trigger && s->count + len >= s->trigger;
+	s->count += len;
+
+	bool must_yield = crossed ? os_handle_list_updateAndCheck( (os_handle_t)s ) : false;
+
+	/* Yield if necessary
+	 ------------------------------------------------------*/
+	if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+
+	/* Exit
+	 ------------------------------------------------------*/
+	OS_EXIT_CRITICAL();
+
+	return len;
+}
+
+
+/***********************************************************************
+ * OS Stream Read
+ *
+ * @brief This function blocks until the trigger level is reached or a timeout occurs, then copies up to len bytes.
+ * On timeout, the bytes already available (if any) are returned.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the stream
+ * @param void* data 				: [out] Buffer to receive the bytes
+ * @param size_t len 				: [ in] Maximum number of bytes to read
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ * @param os_err_e* err 			: [out] Error code. OS_ERR_TIMEOUT if nothing was read. NULL to ignore
+ *
+ * @return size_t : number of bytes read
+ **********************************************************************/
+size_t os_stream_read(os_handle_t h, void* data, size_t len, uint32_t timeout_ticks, os_err_e* err){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_stream_t* s = os_stream_getFromHandle(h);
+	if(s == NULL || data == NULL){
+		if(err != NULL)
+			*err = OS_ERR_BAD_ARG;
+
+		return 0;
+	}
+
+	/* Wait for the trigger level
+	 ------------------------------------------------------*/
+	os_err_e waitErr = OS_ERR_OK;
+	os_obj_single_wait(h, timeout_ticks, &waitErr);
+
+	if(waitErr != OS_ERR_OK && waitErr != OS_ERR_TIMEOUT){
+		if(err != NULL)
+			*err = waitErr;
+
+		return 0;
+	}
+
+	/* Enter critical section
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	/* Copy in up to two chunks (end of buffer, then beginning)
+	 ------------------------------------------------------*/
+	len = len > s->count ? s->count : len;
+
+	size_t first = s->size - s->tail;
+	first = first > len ? len : first;
+
+	memcpy(data, &s->buf[s->tail], first);
+	memcpy((uint8_t*)data + first, &s->buf[0], len - first);
+
+	s->tail = (s->tail + len) % s->size;
+	s->count -= len;
+
+	/* Update block list
+	 ------------------------------------------------------*/
+	os_handle_list_updateAndCheck((os_handle_t)s);
+
+	OS_EXIT_CRITICAL();
+
+	if(err != NULL)
+		*err = len == 0 ? OS_ERR_TIMEOUT : OS_ERR_OK;
+
+	return len;
+}
+
+
+/***********************************************************************
+ * OS Stream Reset
+ *
+ * @brief This function discards every byte in the stream
+ *
+ * @param os_handle_t h : [ in] Handle to the stream
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_stream_reset(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_stream_t* s = os_stream_getFromHandle(h);
+	if(s == NULL) return OS_ERR_BAD_ARG;
+
+	/* Empty buffer
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		s->head  = 0;
+		s->tail  = 0;
+		s->count = 0;
+	);
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Stream Get Count
+ *
+ * @brief This function gets the number of bytes waiting in the stream
+ *
+ * @param os_handle_t h : [ in] Handle to the stream
+ *
+ * @return size_t : number of bytes, 0 if error
+ **********************************************************************/
+size_t os_stream_getCount(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_stream_t* s = os_stream_getFromHandle(h);
+	if(s == NULL) return 0;
+
+	return s->count;
+}
+
+
+/***********************************************************************
+ * OS Stream delete
+ *
+ * @brief This function deletes a stream. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the stream
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_stream_delete(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_stream_t* s = os_stream_getFromHandle(h);
+	if(s == NULL) return OS_ERR_BAD_ARG;
+
+	/* Deletes from obj list and from its wait-set
+	 ------------------------------------------------------*/
+	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	os_list_clear(h->blockList);
+	os_heap_free(s->buf);
+	os_heap_free(h->name);
+
+	return os_heap_free(h);
+}
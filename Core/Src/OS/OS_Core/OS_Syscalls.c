@@ -18,8 +18,8 @@
 /* Syscall stack frame
  ------------------------------------------------------*/
 typedef struct os_syscall_frame_ {
-	os_handle_t syscall_thread;
-	os_handle_t caller_task;
+	void* deferred_fn;
+	uint32_t lr;
 	uint32_t r0;
 	uint32_t r1;
 	uint32_t r2;
@@ -41,8 +41,8 @@ typedef uint32_t (sys_fn_t)(os_syscall_frame_t* frame);
  ------------------------------------------------------*/
 typedef struct os_syscall_table_ {
 	char* name;
-	os_syscall_e call_id;
 	sys_fn_t* sys_fn;
+	bool blocking;
 } os_syscall_table_t;
 
 
@@ -90,48 +90,52 @@ static size_t os_syscall_fwrite(os_syscall_frame_t* frame){
 	return os_fwrite((void*)frame->r1, (size_t)frame->r2, (size_t)frame->r3, (OS_FILE*)frame->r4);
 }
 
+/***********************************************************************
+ * OS Syscall get tick
+ *
+ * @brief This function implements the syscall to os_getMsTick
+ *
+ **********************************************************************/
+static uint32_t os_syscall_getTick(os_syscall_frame_t* frame){
+	UNUSED_ARG(frame);
+	return os_getMsTick();
+}
+
 /**********************************************
  * PRIVATE VARIABLES
  *********************************************/
 
-/* Declare syscall table
+/* Declare syscall table, indexed by syscall ID. Calls that may block (the file system ones wait for its mutex) run in the caller task
  ------------------------------------------------------*/
-static const os_syscall_table_t os_syscall_table[] = {
-		{ .name = "fopen",		.call_id =	OS_SYSCALL_FOPEN,		.sys_fn = (sys_fn_t*)&os_syscall_fopen 		},
-		{ .name = "fclose",		.call_id =	OS_SYSCALL_FCLOSE,		.sys_fn = (sys_fn_t*)&os_syscall_fclose 	},
-		{ .name = "fread",		.call_id =	OS_SYSCALL_FREAD,		.sys_fn = (sys_fn_t*)&os_syscall_fread 		},
-		{ .name = "fwrite",		.call_id =	OS_SYSCALL_FWRITE,		.sys_fn = (sys_fn_t*)&os_syscall_fwrite 	},
+static const os_syscall_table_t os_syscall_table[__OS_SYSCALL_MAX] = {
+		[OS_SYSCALL_FOPEN]		= { .name = "fopen",	.sys_fn = (sys_fn_t*)&os_syscall_fopen, 	.blocking = true 	},
+		[OS_SYSCALL_FCLOSE]		= { .name = "fclose",	.sys_fn = (sys_fn_t*)&os_syscall_fclose, 	.blocking = true 	},
+		[OS_SYSCALL_FREAD]		= { .name = "fread",	.sys_fn = (sys_fn_t*)&os_syscall_fread, 	.blocking = true 	},
+		[OS_SYSCALL_FWRITE]		= { .name = "fwrite",	.sys_fn = (sys_fn_t*)&os_syscall_fwrite, 	.blocking = true 	},
+		[OS_SYSCALL_GETTICK]	= { .name = "gettick",	.sys_fn = (sys_fn_t*)&os_syscall_getTick, 	.blocking = false 	},
 };
 
 
 /***********************************************************************
- * OS Syscall thread
+ * OS Syscall deferred
  *
- * @brief This function calls the syscall function depending on R0 value
+ * @brief This function executes a blocking syscall. It is called by os_syscall in the caller task context, after the SVC returned,
+ * so the syscall can block as any other call made by the task.
  *
  * @param os_syscall_frame_t* frame : [in] Reference to caller stack
  *
- * @return int : always 0
  **********************************************************************/
-static int os_syscall_thread(os_syscall_frame_t* frame){
-	uint32_t* ret = &frame->r0;
-	os_syscall_e call = frame->r0;
-	for(int i = 0; i < COUNTOF(os_syscall_table); i++){
-		if(os_syscall_table[i].call_id == call){
-			*ret = os_syscall_table[i].sys_fn(frame);
-			return 0;
-		}
-	}
-
-	*ret = (uint32_t)OS_ERR_INVALID;
-	return 0;
+static void __used os_syscall_deferred(os_syscall_frame_t* frame){
+	frame->r0 = ((sys_fn_t*)frame->deferred_fn)(frame);
+	frame->deferred_fn = NULL;
 }
 
 
 /***********************************************************************
  * OS Syscall Handler
  *
- * @brief This function invokes a thread to handle the syscall, as well as blocking the caller thread as if it called "os_obj_wait_single"
+ * @brief This function dispatches the syscall in R0. Non blocking syscalls are executed right away, blocking syscalls are handed
+ * back to os_syscall to be executed in the caller task context.
  *
  * @param os_syscall_frame_t* frame : [in] Reference to caller stack
  *
@@ -142,53 +146,30 @@ static void __used os_syscall_handler(os_syscall_frame_t* frame){
 	 ------------------------------------------------------*/
 	int* ret = (int*)&frame->r0;
 
-	/* If scheduler is not running, exit
+	/* If scheduler is not running, PSP does not point to the caller stack. The deferred slot is left as os_syscall pushed it (NULL)
 	 ------------------------------------------------------*/
 	if(os_scheduler_state_get() != OS_SCHEDULER_START){
 		*ret = OS_ERR_FORBIDDEN;
 		return;
 	}
 
-	/* Create syscall thread
-	 ------------------------------------------------------*/
-	os_err_e er = os_task_create(&frame->syscall_thread, NULL, (void*)os_syscall_thread, OS_TASK_MODE_DELETE, 100, OS_DEFAULT_STACK_SIZE, frame);
-	if(er != OS_ERR_OK){
-		*ret = (int)er;
-		goto exit;
-	}
+	os_syscall_e call = frame->r0;
 
-	/* Add caller task to blocking list
+	/* Check ID
 	 ------------------------------------------------------*/
-	frame->caller_task = (os_handle_t) os_task_getCurrentTask();
-	er = os_list_add( frame->syscall_thread->blockList, frame->caller_task, OS_LIST_LAST );
-	if(er != OS_ERR_OK){
-		*ret = (int)er;
-		goto exit_task;
+	if((uint32_t)call >= __OS_SYSCALL_MAX || os_syscall_table[call].sys_fn == NULL){
+		*ret = OS_ERR_INVALID;
+		return;
 	}
 
-	/* Block current task and call scheduler
+	/* Blocking calls cannot run in handler mode, let the caller execute them
 	 ------------------------------------------------------*/
-	os_task_t* t = (os_task_t*) frame->caller_task;
-
-	t->state 			= OS_TASK_BLOCKED;
-	t->wakeCoutdown		= OS_WAIT_FOREVER;
-	t->objWaited 		= (void*)&frame->syscall_thread;
-	t->sizeObjs 		= 1;
-	t->objWanted 		= 0xFFFFFFFF;
-	t->waitFlag 		= OS_OBJ_WAIT_ALL;
-
-	os_task_yeild();
-
-	return;
-
-	/* Cleanup in case of errors
-	 ------------------------------------------------------*/
-
-exit_task:
-	os_task_delete(frame->syscall_thread);
+	if(os_syscall_table[call].blocking){
+		frame->deferred_fn = (void*)os_syscall_table[call].sys_fn;
+		return;
+	}
 
-exit:
-	return;
+	*ret = os_syscall_table[call].sys_fn(frame);
 }
 
 
@@ -199,7 +180,7 @@ exit:
 /***********************************************************************
  * SVC Handler
  *
- * @brief This function implements interrupt handler for SVC. It gets the stack frame prepared by os_syscall to be used by syscall thread
+ * @brief This function implements interrupt handler for SVC. It gets the stack frame prepared by os_syscall to be used by the syscall handler
  *
  * @param os_syscall_frame_t* frame : [in] Reference to caller stack
  *
@@ -247,27 +228,32 @@ void __naked SVC_Handler(void){
 void* __naked os_syscall(os_syscall_e call, void* arg1, void* arg2, void* arg3, void* arg4, void* arg5, void* arg6, void* arg7, void* arg8){
 
 	/* Pushes R0 to R3 in stack. Arm already pushes all arguments beyond 4 to stack, but the first 4 arguments are stored in R0 to R3
-	 * Then, pushes R0 and R1 again, this is to be used by syscall handler to store the syscall thread reference.
-	 * This is complex, because we cannot store the syscall thread reference in the interrupt stack, because it will return before the syscall finishes
-	 * We cannot manipulate the current task stack inside interrupt because that would break the interrupt stack frame
-	 * We cannot use the heap, because we would need to store its reference somewhere
-	 * Global variables are out of the question.
-	 * We could add some members to task structure, but doing it this way is easier
+	 * Then, pushes NULL and LR. The NULL slot is used by the syscall handler to return the blocking syscall to execute, so it stays NULL
+	 * whenever the handler rejects the call. LR is saved there because the blocking syscall is called from here.
+	 * Keeping both in the same 8 bytes leaves the frame layout untouched and SP aligned.
 	 ------------------------------------------------------*/
 	__asm volatile ("push {r0-r3}");
-	__asm volatile ("push {r0-r1}");
+	__asm volatile ("mov r12, #0");
+	__asm volatile ("push {r12, lr}");
 
 	/* Calls interrupt and makes sure no other instruction in executed after it
 	 ------------------------------------------------------*/
 	__asm volatile ("svc 0");
 	__asm volatile ("isb");
-	__asm volatile ("nop");
-	__asm volatile ("nop");
-	__asm volatile ("nop");
 
-	/* Get return value stored in stack by the syscall thread
+	/* If the handler returned a blocking syscall, execute it in the caller context
+	 ------------------------------------------------------*/
+	__asm volatile (
+		"ldr r1, [sp]					\n"	//R1 = deferred syscall
+		"cbz r1, 1f						\n"	//If none, skip
+		"mov r0, sp						\n"	//R0 = frame
+		"bl os_syscall_deferred			\n"	//Execute syscall
+		"1:								\n"
+	);
+
+	/* Get return value stored in stack by the syscall
 	 ------------------------------------------------------*/
-	__asm volatile ("add sp, #8");
+	__asm volatile ("pop {r1, lr}");
 	__asm volatile ("pop {r0}");
 	__asm volatile ("add sp, #12");
 
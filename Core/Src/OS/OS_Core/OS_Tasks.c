@@ -30,6 +30,12 @@ os_handle_t idle_task;	//Idle task handle
 os_list_head_t os_head;				//Head of task list
 os_list_cell_t* os_cur_task = NULL;	//Current task pointer
 
+/**********************************************
+ * PRIVATE VARIABLES
+ *********************************************/
+
+static uint32_t volatile zombieCount = 0;	//Number of tasks that deleted themselves and wait for os_task_reap
+
 /**********************************************
  * PRIVATE FUNCTIONS
  *********************************************/
@@ -143,6 +149,50 @@ static os_err_e os_task_objTake(os_handle_t h, os_handle_t takingTask){
 }
 
 
+/***********************************************************************
+ * OS Task Reap up to
+ *
+ * @brief This function frees at most max tasks that deleted themselves (zombies)
+ *
+ * @param uint32_t max : [ in] maximum number of tasks to free
+ *
+ * @return uint32_t : number of tasks freed
+ *
+ **********************************************************************/
+static uint32_t os_task_reapUpTo(uint32_t max){
+
+	/* Nothing to do most of the time
+	 ------------------------------------------------------*/
+	if(zombieCount == 0) return 0;
+
+	uint32_t n = 0;
+	while(n < max){
+
+		/* Search a zombie (never the running task, it is still on its stack)
+		 ------------------------------------------------------*/
+		os_handle_t zombie = NULL;
+
+		OS_CRITICAL_SECTION(
+			for(os_list_cell_t* it = os_head.head.next; it != NULL; it = it->next){
+				if(it != os_cur_task && ((os_task_t*)it->element)->state == OS_TASK_DELETING){
+					zombie = (os_handle_t)it->element;
+					break;
+				}
+			}
+		);
+
+		if(zombie == NULL) break;
+
+		/* Free it
+		 ------------------------------------------------------*/
+		if(os_task_delete(zombie) != OS_ERR_OK) break;
+		n++;
+	}
+
+	return n;
+}
+
+
 /***********************************************************************
  * OS Task Start
  *
@@ -173,6 +223,10 @@ static os_err_e os_task_start(os_handle_t* h, char const * name, void* (*fn)(int
 	if(stack_size < OS_MINIMUM_STACK_SIZE)  return OS_ERR_BAD_ARG;
 	if(os_init_get() == false)				return OS_ERR_NOT_READY;
 
+	/* Free some zombies first, in case the idle task does not get to run
+	 ------------------------------------------------------*/
+	os_task_reapUpTo(OS_TASK_REAP_ON_CREATE);
+
 	/* If task exists, return it
 	 ------------------------------------------------------*/
 	if(name != NULL){
@@ -191,9 +245,9 @@ static os_err_e os_task_start(os_handle_t* h, char const * name, void* (*fn)(int
 	 ------------------------------------------------------*/
 	if(t == NULL) return OS_ERR_INSUFFICIENT_HEAP;
 
-	/* Alloc the stack
+	/* Alloc the stack (in the arena of the process if any)
 	 ------------------------------------------------------*/
-	uint32_t stk = (uint32_t) os_heap_alloc(stack_size);
+	uint32_t stk = (uint32_t) (proc != NULL && proc->arena != NULL ? os_heap_arenaAlloc(proc->arena, stack_size) : os_heap_alloc(stack_size));
 	if(stk == 0){
 		os_heap_free(t);
 		return OS_ERR_INSUFFICIENT_HEAP;
@@ -205,6 +259,7 @@ static os_err_e os_task_start(os_handle_t* h, char const * name, void* (*fn)(int
 	t->obj.type			= OS_OBJ_TASK;
 	t->obj.getFreeCount	= &os_task_getFreeCount;
 	t->obj.blockList	= os_list_init();
+	t->obj.waitSet		= NULL;
 	t->obj.obj_take		= &os_task_objTake;
 	t->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
 
@@ -220,6 +275,7 @@ static os_err_e os_task_start(os_handle_t* h, char const * name, void* (*fn)(int
 	t->sizeObjs 		= 0;
 	t->retVal			= NULL;
 	t->ownedMutex		= os_list_init();
+	t->rwMode			= OS_RWLOCK_MODE_READ;
 
 	t->argc				= argv == NULL ? 0 : (int)argc;
 	t->argv				= argv;
@@ -232,7 +288,7 @@ static os_err_e os_task_start(os_handle_t* h, char const * name, void* (*fn)(int
 	*--t->pStack = (mode == OS_TASK_MODE_RETURN) ? (uint32_t) &os_task_return : (uint32_t) &os_task_end;  //LR
 	*--t->pStack = (uint32_t) 0;				//R12
 	*--t->pStack = (uint32_t) 0;			 	//R3
-	*--t->pStack = (uint32_t) 0;			 	//R2
+	*--t->pStack = (uint32_t) (proc == NULL ? NULL : os_kdata_get());	//R2 (argument 3, kernel data page for processes)
 	*--t->pStack = (uint32_t) argv;			 	//R1 (argument 2)
 	*--t->pStack = (uint32_t) argc;			 	//R0 (argument 1)
 
@@ -347,6 +403,7 @@ os_err_e os_task_init(char* main_name, int8_t main_task_priority, uint32_t inter
 	t->obj.type				= OS_OBJ_TASK;
 	t->obj.getFreeCount		= &os_task_getFreeCount;
 	t->obj.blockList		= os_list_init();
+	t->obj.waitSet			= NULL;
 	t->obj.obj_take			= &os_task_objTake;
 	t->obj.name				= main_name == NULL ? NULL : (char*)os_heap_alloc(strlen(main_name) + 1);
 
@@ -361,6 +418,7 @@ os_err_e os_task_init(char* main_name, int8_t main_task_priority, uint32_t inter
 	t->retVal				= NULL;
 
 	t->ownedMutex			= os_list_init();
+	t->rwMode				= OS_RWLOCK_MODE_READ;
 	t->argc					= 0;
 	t->argv					= NULL;
 
@@ -488,7 +546,8 @@ os_err_e os_task_create(os_handle_t* h, char const * name, void* (*fn)(void*), o
 /***********************************************************************
  * OS Task Create Process flavor
  *
- * @brief This function creates a new task, that will be called by the scheduler when the correct time comes
+ * @brief This function creates a new task, that will be called by the scheduler when the correct time comes.
+ * The kernel data page (os_kdata_t const*) is passed as the third argument of fn.
  *
  * @param os_handle_t* h						: [out] handle to object
  * @param char* name 							: [ in] name of the task
@@ -501,11 +560,15 @@ os_err_e os_task_create(os_handle_t* h, char const * name, void* (*fn)(void*), o
  * @param char** argv  						    : [ in] argv argument to be passed to the task
  * @param uint32_t r9  						    : [ in] r9 value (must be GOT base address)
  *
- * @return os_err_e : An error code (0 = OK)
+ * @return os_err_e : An error code (0 = OK). OS_ERR_FORBIDDEN if the process reached its thread limit
  *
  **********************************************************************/
 os_err_e os_task_createProc(os_handle_t* h, char const * name, int (*fn)(int argc, char* argv[]), os_process_t* proc, os_task_mode_e mode, int8_t priority, uint32_t stack_size, int argc, char** argv, uint32_t r9){
 
+	/* Check the thread limit of the process
+	 ------------------------------------------------------*/
+	if(proc != NULL && ((os_list_head_t*)proc->thread_list)->listSize >= proc->limits.maxThreads) return OS_ERR_FORBIDDEN;
+
 	/* Start task with the correct arguments
 	 ------------------------------------------------------*/
 	return os_task_start(h, name, (void*)fn, proc, mode, priority, stack_size, (void*)argc, argv, r9);
@@ -544,6 +607,7 @@ os_err_e os_task_return(void* retVal){
 	/* Check scheduler
 	 ------------------------------------------------------*/
 	if(os_scheduler_state_get() != OS_SCHEDULER_START) return OS_ERR_NOT_READY;
+	if(os_scheduler_isLocked()) return OS_ERR_FORBIDDEN;
 
 	/* Enter critical section
 	------------------------------------------------------*/
@@ -586,7 +650,8 @@ os_err_e os_task_return(void* retVal){
 /***********************************************************************
  * OS Task delete
  *
- * @brief This function deletes a task, removing it from task list and freeing its block
+ * @brief This function deletes a task, removing it from task list and freeing its block.
+ * A task deleting itself only becomes a zombie: its memory is freed later by os_task_reap, outside the context switch.
  *
  * ATTENTION : if the current tasks kills itself, the IRQ will be enabled regardless of its previous state
  *
@@ -614,12 +679,17 @@ os_err_e os_task_delete(os_handle_t h){
 	/* Check scheduler, we cannot kill the current task if scheduler is not ready
 	 ------------------------------------------------------*/
 	if(h == os_cur_task->element && os_scheduler_state_get() != OS_SCHEDULER_START) return OS_ERR_NOT_READY;
+	if(h == os_cur_task->element && os_scheduler_isLocked()) return OS_ERR_FORBIDDEN;
 
 	/* Enter critical section
 	------------------------------------------------------*/
 	OS_DECLARE_IRQ_STATE;
 	OS_ENTER_CRITICAL();
 
+	/* Check if we are freeing a zombie
+	 ------------------------------------------------------*/
+	bool zombie = t->state == OS_TASK_DELETING && h != os_cur_task->element;
+
 	/* Tag as ended
 	 ------------------------------------------------------*/
 	t->state = OS_TASK_ENDED;
@@ -632,9 +702,10 @@ os_err_e os_task_delete(os_handle_t h){
 	 ------------------------------------------------------*/
 	if(h == os_cur_task->element){
 
-		/* Tag task to delete
+		/* Tag task as zombie. The scheduler only switches away from it, os_task_reap frees it
 		 ------------------------------------------------------*/
 		t->state = OS_TASK_DELETING;
+		zombieCount++;
 
 		/* Failsafe
 		 ------------------------------------------------------*/
@@ -655,13 +726,18 @@ os_err_e os_task_delete(os_handle_t h){
 		return OS_ERR_UNKNOWN;
 	}
 
+	/* Detach from the process. The process dies with its last thread (a thread deleting itself gets here when reaped),
+	 * once the thread's memory is freed, as its stack and arguments live in the process arena.
+	 * A thread not listed (process still being loaded) never kills it
+	 ------------------------------------------------------*/
+	os_process_t* lastOf = NULL;
 	if( t->process != NULL ){
-		if( ((os_list_head_t*)t->process->thread_list)->listSize == 0 ){
-			ASSERT(os_process_kill(t->process) == OS_ERR_OK);
-		}
-		else {
-			os_list_remove( ((os_process_t*)t->process)->thread_list, t);
-		}
+		os_err_e listed = os_list_remove( ((os_process_t*)t->process)->thread_list, t);
+
+		if( listed == OS_ERR_OK && ((os_list_head_t*)t->process->thread_list)->listSize == 0 )
+			lastOf = t->process;
+
+		t->process = NULL;
 	}
 
 	/* Remove task from object block list if needed
@@ -689,9 +765,10 @@ os_err_e os_task_delete(os_handle_t h){
 
 	}
 
-	/* Deletes from obj list
+	/* Deletes from obj list and from its wait-set
 	 ------------------------------------------------------*/
 	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
 
 	/* Remove task from list
 	 ------------------------------------------------------*/
@@ -705,10 +782,9 @@ os_err_e os_task_delete(os_handle_t h){
 	 ------------------------------------------------------*/
 	os_list_clear(t->ownedMutex);
 
-	/* Free code, name, and arguments if they were created by os_createProcess
+	/* Free arguments if they were created by os_createProcess
 	 ------------------------------------------------------*/
 	if(t->argc > 0){
-		os_heap_free(t->fnPtr);
 		for(int i = 0; i < t->argc && t->argv != NULL; i++){
 			os_heap_free(t->argv[i]);
 			t->argv[i] = NULL;
@@ -737,6 +813,14 @@ os_err_e os_task_delete(os_handle_t h){
 	os_heap_free(h->name);
 	os_heap_free(h);
 
+	if(zombie) zombieCount--;
+
+	/* Kill the process left without threads
+	 ------------------------------------------------------*/
+	if(lastOf != NULL){
+		ASSERT(os_process_kill(lastOf) == OS_ERR_OK);
+	}
+
 	/* Return
 	 ------------------------------------------------------*/
 	OS_EXIT_CRITICAL();
@@ -744,6 +828,20 @@ os_err_e os_task_delete(os_handle_t h){
 }
 
 
+/***********************************************************************
+ * OS Task Reap
+ *
+ * @brief This function frees every task that deleted itself (zombie). It is called by the default idle task;
+ * a custom os_idle_task_fn (or any low priority task) should call it too. Task creations free up to OS_TASK_REAP_ON_CREATE zombies as well.
+ *
+ * @return uint32_t : number of tasks freed
+ *
+ **********************************************************************/
+uint32_t os_task_reap(){
+	return os_task_reapUpTo(UINT32_MAX);
+}
+
+
 /***********************************************************************
  * OS Task Yeild
  *
@@ -805,6 +903,7 @@ os_err_e os_task_sleep(uint32_t sleep_ticks){
 	/* Check scheduler stop
 	 ------------------------------------------------------*/
 	if(os_scheduler_state_get() == OS_SCHEDULER_STOP) return OS_ERR_NOT_READY;
+	if(os_scheduler_isLocked()) return OS_ERR_FORBIDDEN;
 
 	/* Check if we are in thread mode (cannot sleep in interupt mode)
 	 ---------------------------------------------------*/
@@ -63,6 +63,11 @@ void os_tick(uint32_t ms_inc){
 	/* Increment ticks
 	 ------------------------------------------------------*/
 	os_ticks_ms += ms_inc;
+	os_kdata_setTick(os_ticks_ms);
+
+	/* Charge the running process (may throttle it)
+	 ------------------------------------------------------*/
+	os_process_tick(ms_inc);
 
 	/* Create iterators
 	 ------------------------------------------------------*/
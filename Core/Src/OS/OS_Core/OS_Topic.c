@@ -24,7 +24,7 @@ extern os_list_head_t  os_obj_head;	//Current task pointer
 ------------------------------------------------------*/
 typedef struct os_topic_msgQList_el_{
     os_handle_t associated_task;
-    os_handle_t msgQ;
+    os_handle_t msgQ;               //Message queue (queued topics) or mailbox (conflated topics)
 } os_topic_msgQList_el_t;
 
 /**********************************************
@@ -62,6 +62,24 @@ static os_topic_msgQList_el_t* os_topic_searchTaskInList(os_list_head_t* head, o
 }
 
 
+/***********************************************************************
+ * OS Topic delete inbox
+ *
+ * @brief Deletes the message queue or mailbox associated with a subscriber
+ *
+ * @param os_topic_t* t  : [in] Topic
+ * @param os_handle_t h  : [in] Message queue or mailbox to delete
+ *
+ * @return os_err_e : Error code
+ **********************************************************************/
+static os_err_e os_topic_deleteInbox(os_topic_t* t, os_handle_t h){
+    if(t->mode == OS_TOPIC_MODE_CONFLATED)
+        return os_mbox_delete(h);
+
+    return os_msgQ_delete(h);
+}
+
+
 /***********************************************************************
  * OS topic get free count
  *
@@ -107,20 +125,22 @@ static os_err_e os_topic_objTake(os_handle_t h, os_handle_t takingTask){
  *********************************************/
 
 /***********************************************************************
- * OS Topic create
+ * OS Topic create mode
  *
- * @brief Creates a new topic
+ * @brief Creates a new topic with the given mode
  *
- * @param os_handle_t* h : [out] Topic handle
- * @param char* name     : [ in] Topic name or NULL to create an nameless topic
+ * @param os_handle_t* h        : [out] Topic handle
+ * @param os_topic_mode_e mode  : [ in] Topic mode. Conflated topics only keep the latest message for each subscriber
+ * @param char* name            : [ in] Topic name or NULL to create an nameless topic
  *
  * @return os_err_e error code (0 = OK)
  **********************************************************************/
-os_err_e os_topic_create(os_handle_t* h, char const * name)
+os_err_e os_topic_createMode(os_handle_t* h, os_topic_mode_e mode, char const * name)
 {
     /* Arg check
 	------------------------------------------------------*/
     if(h == NULL) 			        return OS_ERR_BAD_ARG;
+    if(mode >= __OS_TOPIC_MODE_INVALID) return OS_ERR_BAD_ARG;
     if(name == NULL) 		        return OS_ERR_BAD_ARG;
 	if(os_init_get() == false)		return OS_ERR_NOT_READY;
 
@@ -145,10 +165,12 @@ os_err_e os_topic_create(os_handle_t* h, char const * name)
     topic->obj.objUpdate	= 0;
     topic->obj.getFreeCount	= &os_topic_getFreeCount;
     topic->obj.blockList	= os_list_init();
+    topic->obj.waitSet		= NULL;
     topic->obj.obj_take		= &os_topic_objTake;
     topic->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
 
     topic->msgQlist 		= os_list_init();
+    topic->mode             = mode;
 
     /* Handles allocation errors
 	------------------------------------------------------*/
@@ -216,10 +238,10 @@ os_err_e os_topic_subscribe(os_handle_t topic){
     if(el == NULL)
         return OS_ERR_INSUFFICIENT_HEAP;
 
-    /* Create messageQ to associate with the task
+    /* Create messageQ (or mailbox if conflated) to associate with the task
     ------------------------------------------------------*/
     os_handle_t msgQ;
-    os_err_e err = os_msgQ_create(&msgQ, OS_MSGQ_MODE_FIFO, NULL);
+    os_err_e err = t->mode == OS_TOPIC_MODE_CONFLATED ? os_mbox_create(&msgQ, NULL) : os_msgQ_create(&msgQ, OS_MSGQ_MODE_FIFO, NULL);
     if(err != OS_ERR_OK){
         os_heap_free(el);
         return err;
@@ -263,9 +285,9 @@ os_err_e os_topic_unsubscribeTask(os_handle_t topic, os_handle_t task){
     if(err != OS_ERR_OK)
         return err;
 
-    /* Search for task to unsubscribe
+    /* Delete the task's message queue
     ------------------------------------------------------*/
-    err = os_msgQ_delete(el->msgQ);
+    err = os_topic_deleteInbox(t, el->msgQ);
     if(err != OS_ERR_OK)
         return err;
         
@@ -301,7 +323,49 @@ void* os_topic_receive(os_handle_t topic, os_err_e* err){
     ------------------------------------------------------*/
     os_topic_msgQList_el_t* el = os_topic_searchTaskInList(t->msgQlist, (os_handle_t) os_task_getCurrentTask());
     if(el != NULL)
-        return os_msgQ_pop(el->msgQ, err);
+        return t->mode == OS_TOPIC_MODE_CONFLATED ? os_mbox_read(el->msgQ, NULL, err) : os_msgQ_pop(el->msgQ, err);
+
+    /* Task not found
+    ------------------------------------------------------*/
+    if(err != NULL) 
+        *err = OS_ERR_INVALID;
+
+    return NULL;
+}
+
+
+/***********************************************************************
+ * OS Topic Receive Latest
+ *
+ * @brief Receive the latest message published in a conflated topic, along with its sequence number.
+ * Gaps in the sequence tell how many messages were overwritten since the last read.
+ *
+ * @param os_handle_t topic : [ in] Handle to topic
+ * @param uint32_t* seq     : [out] Sequence number of the message (or null to ignore)
+ * @param os_err_e* err     : [out] Error code (or null to ignore)
+ * 
+ * @return void* : message or NULL if nothing
+ **********************************************************************/
+void* os_topic_receiveLatest(os_handle_t topic, uint32_t* seq, os_err_e* err){
+
+    /* Convert address
+    ------------------------------------------------------*/
+    os_topic_t* t = (os_topic_t*)topic; 
+
+	/* Check arguments
+    ------------------------------------------------------*/
+	if(topic == NULL || topic->type != OS_OBJ_TOPIC || t->mode != OS_TOPIC_MODE_CONFLATED){
+        if(err != NULL) 
+            *err = OS_ERR_BAD_ARG;
+
+        return NULL;
+    } 
+
+    /* Search for task in task list and read its mailbox
+    ------------------------------------------------------*/
+    os_topic_msgQList_el_t* el = os_topic_searchTaskInList(t->msgQlist, (os_handle_t) os_task_getCurrentTask());
+    if(el != NULL)
+        return os_mbox_read(el->msgQ, seq, err);
 
     /* Task not found
     ------------------------------------------------------*/
@@ -340,7 +404,7 @@ os_err_e os_topic_publish(os_handle_t topic, void* msg){
 	while(it != NULL && it->element != NULL){
         os_topic_msgQList_el_t* el = (os_topic_msgQList_el_t*)it->element;
 
-        os_err_e ret = os_msgQ_push(el->msgQ, msg);
+        os_err_e ret = t->mode == OS_TOPIC_MODE_CONFLATED ? os_mbox_post(el->msgQ, msg) : os_msgQ_push(el->msgQ, msg);
         if(ret != OS_ERR_OK)
             return ret;
 
@@ -376,18 +440,20 @@ os_err_e os_topic_delete(os_handle_t topic){
     os_list_cell_t* it = ((os_list_head_t*) t->msgQlist)->head.next;
 
 	while(it != NULL){
-        os_err_e ret = os_msgQ_delete(((os_topic_msgQList_el_t*)it->element)->msgQ);
+        os_err_e ret = os_topic_deleteInbox(t, ((os_topic_msgQList_el_t*)it->element)->msgQ);
         if(ret != OS_ERR_OK)
             return ret;
 
         it = it->next;
 	}
 
-	/* Deletes from obj list
+	/* Deletes from obj list and from its wait-set
 	------------------------------------------------------*/
 	os_err_e ret = os_list_remove(&os_obj_head, topic);
     if(ret != OS_ERR_OK)
         return ret;
+
+    os_waitset_detach(topic);
         
     /* delete topic contents
     ------------------------------------------------------*/
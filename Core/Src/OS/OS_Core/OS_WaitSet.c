@@ -0,0 +1,362 @@
+/*
+ * OS_WaitSet.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_obj_head;	//Head to obj list
+extern os_list_cell_t* os_cur_task;	//Current task pointer
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Wait-set get free count
+ *
+ * @brief Gets the number of registered objects available for a given task
+ *
+ * @param os_handle_t h 			: [in] object to verify the availability
+ * @param os_handle_t takingTask	: [in] task that would take the objects
+ *
+ * @return uint32_t : the number of available objects
+ *
+ **********************************************************************/
+static uint32_t os_waitset_getFreeCount(os_handle_t h, os_handle_t takingTask){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_waitset_t* ws = os_waitset_getFromHandle(h);
+	if(ws == NULL) return 0;
+
+	/* Count every available member
+	 ------------------------------------------------------*/
+	uint32_t freeCount = 0;
+	for(os_list_cell_t* it = ((os_list_head_t*)ws->memberList)->head.next; it != NULL; it = it->next){
+		os_handle_t member = (os_handle_t)it->element;
+
+		if(member->getFreeCount(member, takingTask) > 0)
+			freeCount++;
+	}
+
+	return freeCount;
+}
+
+
+/***********************************************************************
+ * OS Wait-set take
+ *
+ * @brief Unused. The registered objects are taken by the caller
+ *
+ * @param os_handle_t h 			: [in] object to take
+ * @param os_handle_t takingTask	: [in] handle to the task that is taking the object
+ *
+ * @return os_err_e : 0 if OK
+ **********************************************************************/
+static os_err_e os_waitset_objTake(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(h);
+	UNUSED_ARG(takingTask);
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Wait-set detach
+ *
+ * @brief This function unregisters an object from its wait-set, if any. Every delete function calls it
+ * so that a wait-set never keeps a pointer to a freed object.
+ *
+ * @param os_handle_t obj : [in] object being deleted
+ **********************************************************************/
+void os_waitset_detach(os_handle_t obj){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(obj == NULL) return;
+
+	/* Unregister object
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		os_waitset_t* ws = os_waitset_getFromHandle(obj->waitSet);
+		if(ws != NULL)
+			os_list_remove(ws->memberList, obj);
+
+		obj->waitSet = NULL;
+	);
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Wait-set Create
+ *
+ * @brief This function creates a wait-set. Objects are registered once, then the wait-set can be waited
+ * any number of times without registering the task in each object's block list.
+ *
+ * @param os_handle_t* h 	: [out] handle to wait-set
+ * @param char* name		: [ in] wait-set name. If a wait-set with the same name already exists, its reference is returned. A null name always creates a nameless wait-set.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_waitset_create(os_handle_t* h, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(h == NULL) 							return OS_ERR_BAD_ARG;
+	if(os_init_get() == false)				return OS_ERR_NOT_READY;
+
+	/* If wait-set exists, return it
+	 ------------------------------------------------------*/
+	if(name != NULL){
+		os_list_cell_t* obj = os_handle_list_searchByName(&os_obj_head, OS_OBJ_WAITSET, name);
+		if(obj != NULL){
+			*h = obj->element;
+			return OS_ERR_OK;
+		}
+	}
+
+	/* Alloc the wait-set block
+	 ------------------------------------------------------*/
+	os_waitset_t* ws = (os_waitset_t*)os_heap_alloc(sizeof(os_waitset_t));
+
+	/* Check allocation
+	 ------------------------------------------------------*/
+	if(ws == 0) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init wait-set
+	 ------------------------------------------------------*/
+	ws->obj.type 			= OS_OBJ_WAITSET;
+	ws->obj.objUpdate 		= 0;
+	ws->obj.getFreeCount	= os_waitset_getFreeCount;
+	ws->obj.obj_take 		= os_waitset_objTake;
+	ws->obj.blockList		= os_list_init();
+	ws->obj.waitSet			= NULL;
+	ws->obj.name			= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
+
+	/* Finish init
+	 ------------------------------------------------------*/
+	ws->memberList			= os_list_init();
+
+	/* Handles heap errors
+	 ------------------------------------------------------*/
+	if(ws->obj.blockList == NULL || ws->memberList == NULL || (ws->obj.name == NULL && name != NULL) ){
+		os_list_clear(ws->obj.blockList);
+		os_list_clear(ws->memberList);
+		os_heap_free(ws->obj.name);
+		os_heap_free(ws);
+
+		return OS_ERR_INSUFFICIENT_HEAP;
+	}
+
+	/* Copy name
+	 ------------------------------------------------------*/
+	if(name != NULL)
+		strcpy(ws->obj.name, name);
+
+	/* Add object to object list
+	 ------------------------------------------------------*/
+	os_err_e ret = os_list_add(&os_obj_head, (os_handle_t) ws, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) {
+		os_list_clear(ws->obj.blockList);
+		os_list_clear(ws->memberList);
+		os_heap_free(ws->obj.name);
+		os_heap_free(ws);
+
+		return ret;
+	}
+
+	/* Return
+	 ------------------------------------------------------*/
+	*h = (os_handle_t)ws;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Wait-set Add
+ *
+ * @brief This function registers an object in the wait-set. An object can only belong to one wait-set at a time.
+ *
+ * @param os_handle_t h 	: [ in] Handle to the wait-set
+ * @param os_handle_t obj 	: [ in] Object to register (any object but a wait-set)
+ *
+ * @return os_err_e OS_ERR_OK if OK, OS_ERR_INVALID if the object already belongs to another wait-set
+ **********************************************************************/
+os_err_e os_waitset_add(os_handle_t h, os_handle_t obj){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_waitset_t* ws = os_waitset_getFromHandle(h);
+	if(ws == NULL) 							return OS_ERR_BAD_ARG;
+	if(obj == NULL) 						return OS_ERR_BAD_ARG;
+	if(obj->type == OS_OBJ_WAITSET) 		return OS_ERR_BAD_ARG;
+	if(obj->waitSet == h) 					return OS_ERR_OK;
+	if(obj->waitSet != NULL) 				return OS_ERR_INVALID;
+
+	/* Register object
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_err_e ret = os_list_add(ws->memberList, obj, OS_LIST_LAST);
+	if(ret != OS_ERR_OK){
+		OS_EXIT_CRITICAL();
+		return ret;
+	}
+
+	obj->waitSet = h;
+
+	/* The object may already be available
+	 ------------------------------------------------------*/
+	bool must_yield = os_handle_list_updateAndCheck(h);
+
+	/* Yield if necessary
+	 ------------------------------------------------------*/
+	if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+
+	OS_EXIT_CRITICAL();
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Wait-set Remove
+ *
+ * @brief This function unregisters an object from the wait-set. Deleting the object unregisters it as well.
+ *
+ * @param os_handle_t h 	: [ in] Handle to the wait-set
+ * @param os_handle_t obj 	: [ in] Object to unregister
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_waitset_remove(os_handle_t h, os_handle_t obj){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_waitset_t* ws = os_waitset_getFromHandle(h);
+	if(ws == NULL) 							return OS_ERR_BAD_ARG;
+	if(obj == NULL) 						return OS_ERR_BAD_ARG;
+	if(obj->waitSet != h) 					return OS_ERR_INVALID;
+
+	/* Unregister object
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_err_e ret = os_list_remove(ws->memberList, obj);
+	obj->waitSet = NULL;
+
+	OS_EXIT_CRITICAL();
+
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS Wait-set Wait
+ *
+ * @brief This function blocks until at least one registered object is available, then lists every available object.
+ * Objects are not taken: the caller takes them afterwards (e.g. os_obj_single_wait with OS_WAIT_NONE, os_msgQ_pop...).
+ * A task blocked on a wait-set does not lend its priority to the owners of registered mutexes.
+ *
+ * @param os_handle_t h 			: [ in] Handle to the wait-set
+ * @param os_handle_t ready[] 		: [out] Array receiving the available objects
+ * @param size_t maxReady 			: [ in] Size of the ready array
+ * @param uint32_t timeout_ticks 	: [ in] Amount of time to wait. OS_WAIT_FOREVER and OS_WAIT_NONE are accepted
+ * @param os_err_e* err 			: [out] Error code. NULL to ignore
+ *
+ * @return size_t : number of objects written in the ready array
+ **********************************************************************/
+size_t os_waitset_wait(os_handle_t h, os_handle_t ready[], size_t maxReady, uint32_t timeout_ticks, os_err_e* err){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_waitset_t* ws = os_waitset_getFromHandle(h);
+	if(ws == NULL || ready == NULL || maxReady == 0){
+		if(err != NULL)
+			*err = OS_ERR_BAD_ARG;
+
+		return 0;
+	}
+
+	/* Only the wait-set itself is waited, members are never touched here
+	 ------------------------------------------------------*/
+	os_err_e waitErr = OS_ERR_OK;
+	if(os_obj_single_wait(h, timeout_ticks, &waitErr) == NULL){
+		if(err != NULL)
+			*err = waitErr;
+
+		return 0;
+	}
+
+	/* Collect every available member
+	 ------------------------------------------------------*/
+	size_t n = 0;
+
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	for(os_list_cell_t* it = ((os_list_head_t*)ws->memberList)->head.next; it != NULL && n < maxReady; it = it->next){
+		os_handle_t member = (os_handle_t)it->element;
+
+		if(member->getFreeCount(member, os_cur_task->element) > 0)
+			ready[n++] = member;
+	}
+
+	OS_EXIT_CRITICAL();
+
+	if(err != NULL)
+		*err = OS_ERR_OK;
+
+	return n;
+}
+
+
+/***********************************************************************
+ * OS Wait-set delete
+ *
+ * @brief This function unregisters every object and deletes the wait-set. It must not be called if there is a task waiting for it.
+ *
+ * @param os_handle_t h : [ in] Handle to the wait-set
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_waitset_delete(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_waitset_t* ws = os_waitset_getFromHandle(h);
+	if(ws == NULL) return OS_ERR_BAD_ARG;
+
+	/* Deletes from obj list
+	 ------------------------------------------------------*/
+	os_list_remove(&os_obj_head, h);
+
+	/* Unregister every member
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		for(os_list_cell_t* it = ((os_list_head_t*)ws->memberList)->head.next; it != NULL; it = it->next)
+			((os_handle_t)it->element)->waitSet = NULL;
+	);
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	os_list_clear(ws->memberList);
+	os_list_clear(h->blockList);
+	os_heap_free(h->name);
+
+	return os_heap_free(h);
+}
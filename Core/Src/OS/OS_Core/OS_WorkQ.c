@@ -0,0 +1,475 @@
+/*
+ * OS_WorkQ.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+
+/**********************************************
+ * EXTERN VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_obj_head;	//Head to obj list
+extern os_list_cell_t* os_cur_task;	//Current task pointer
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS Work Queue get free count
+ *
+ * @brief Gets whether every submitted work is done
+ *
+ * @param os_handle_t h : [in] object to verify the availability
+ *
+ * @return uint32_t : OS_OBJ_COUNT_INF if the queue is idle, 0 otherwise
+ *
+ **********************************************************************/
+static uint32_t os_workq_getFreeCount(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(takingTask);
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_workq_t* q = os_workq_getFromHandle(h);
+	if(q == NULL) return 0;
+
+	return q->busy == 0 ? OS_OBJ_COUNT_INF : 0;
+}
+
+
+/***********************************************************************
+ * OS Work Queue take
+ *
+ * @brief Unused. Waiting for a work queue does not consume anything
+ *
+ * @param os_handle_t h 			: [in] object to take
+ * @param os_handle_t takingTask	: [in] handle to the task that is taking the object
+ *
+ * @return os_err_e : 0 if OK
+ **********************************************************************/
+static os_err_e os_workq_objTake(os_handle_t h, os_handle_t takingTask){
+	UNUSED_ARG(h);
+	UNUSED_ARG(takingTask);
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Work Queue promote due works
+ *
+ * @brief Moves the delayed works that are due to the ready queue
+ *
+ * @param os_workq_t* q : [in] work queue
+ *
+ * @return uint32_t : ms until the next delayed work is due, OS_WAIT_FOREVER if there is none
+ **********************************************************************/
+static uint32_t os_workq_promoteDue(os_workq_t* q){
+
+	uint32_t timeout = OS_WAIT_FOREVER;
+
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	uint32_t now = os_getMsTick();
+
+	/* Scan delayed works
+	 ------------------------------------------------------*/
+	os_list_cell_t* it = ((os_list_head_t*)q->delayedList)->head.next;
+	while(it != NULL){
+		os_work_t* work = (os_work_t*)it->element;
+		it = it->next;
+
+		/* Not due yet, keep the closest deadline
+		 ------------------------------------------------------*/
+		int32_t left = (int32_t)(work->due - now);
+		if(left > 0){
+			timeout = (uint32_t)left < timeout ? (uint32_t)left : timeout;
+			continue;
+		}
+
+		/* Due, move it to the ready queue (it stays delayed if the queue is out of memory)
+		 ------------------------------------------------------*/
+		if(os_msgQ_push(q->queue, work) == OS_ERR_OK)
+			os_list_remove(q->delayedList, work);
+		else
+			timeout = 1;
+	}
+
+	OS_EXIT_CRITICAL();
+
+	return timeout;
+}
+
+
+/***********************************************************************
+ * OS Work Queue worker
+ *
+ * @brief Main function of the worker tasks. Waits for works and executes them one at a time
+ *
+ * @param void* arg : [in] work queue
+ *
+ * @return void* : NULL once the work queue is being deleted
+ **********************************************************************/
+static void* os_workq_worker(void* arg){
+
+	os_workq_t* q = (os_workq_t*)arg;
+
+	while(q->stop == false){
+
+		/* Wait for a work, a kick, or the next delayed work
+		 ------------------------------------------------------*/
+		os_err_e err = OS_ERR_OK;
+		os_obj_multiple_WaitOne(&err, os_workq_promoteDue(q), 2, q->queue, q->kick);
+
+		if(q->stop) break;
+
+		/* Get work, another worker may have been faster
+		 ------------------------------------------------------*/
+		os_work_t* work = (os_work_t*)os_msgQ_pop(q->queue, &err);
+		if(work == NULL) continue;
+
+		/* Execute it
+		 ------------------------------------------------------*/
+		work->fn(work->arg);
+
+		if(work->doneEvt != NULL)
+			os_evt_set(work->doneEvt);
+
+		os_heap_free(work);
+
+		/* Wake up the tasks waiting for the queue to be idle
+		 ------------------------------------------------------*/
+		OS_CRITICAL_SECTION(
+			q->busy--;
+
+			bool must_yield = q->busy == 0 ? os_handle_list_updateAndCheck((os_handle_t)q) : false;
+			if(must_yield && os_scheduler_state_get() == OS_SCHEDULER_START) os_task_yeild();
+		);
+	}
+
+	/* Pass the stop request on to the next idle worker
+	 ------------------------------------------------------*/
+	os_evt_set(q->kick);
+
+	return NULL;
+}
+
+
+/***********************************************************************
+ * OS Work Queue new work
+ *
+ * @brief Allocates and fills a work item
+ *
+ * @return os_work_t* : the work or NULL if out of memory
+ **********************************************************************/
+static os_work_t* os_workq_newWork(void (*fn)(void*), void* arg, os_handle_t doneEvt, uint32_t due){
+
+	os_work_t* work = (os_work_t*)os_heap_alloc(sizeof(os_work_t));
+	if(work == NULL) return NULL;
+
+	work->fn		= fn;
+	work->arg		= arg;
+	work->doneEvt	= doneEvt;
+	work->due		= due;
+
+	return work;
+}
+
+
+/***********************************************************************
+ * OS Work Queue free
+ *
+ * @brief Frees the workers and the memory of a work queue
+ *
+ * @param os_workq_t* q : [in] work queue
+ **********************************************************************/
+static void os_workq_free(os_workq_t* q){
+
+	/* Delete workers
+	 ------------------------------------------------------*/
+	for(size_t i = 0; q->workers != NULL && i < q->nWorkers; i++){
+		if(q->workers[i] != NULL)
+			os_task_delete(q->workers[i]);
+	}
+
+	/* Drop the works not executed
+	 ------------------------------------------------------*/
+	if(q->queue != NULL){
+		os_err_e err = OS_ERR_OK;
+		for(os_work_t* work = os_msgQ_pop(q->queue, &err); work != NULL; work = os_msgQ_pop(q->queue, &err))
+			os_heap_free(work);
+
+		os_msgQ_delete(q->queue);
+	}
+
+	if(q->delayedList != NULL){
+		for(os_list_cell_t* it = ((os_list_head_t*)q->delayedList)->head.next; it != NULL; it = it->next)
+			os_heap_free(it->element);
+
+		os_list_clear(q->delayedList);
+	}
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	if(q->kick != NULL) os_evt_delete(q->kick);
+	os_heap_free(q->workers);
+	os_list_clear(q->obj.blockList);
+	os_heap_free(q->obj.name);
+	os_heap_free(q);
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS Work Queue Create
+ *
+ * @brief This function creates a work queue and its worker tasks. Works are executed in submission order by the first free worker.
+ * Waiting for a work queue returns once every work submitted is done.
+ *
+ * @param os_handle_t* h 		: [out] handle to work queue
+ * @param size_t nWorkers 		: [ in] Number of worker tasks (at least 1)
+ * @param int8_t priority 		: [ in] Priority of the worker tasks
+ * @param uint32_t stack_size 	: [ in] Stack size of each worker task
+ * @param char* name			: [ in] work queue name. If a work queue with the same name already exists, its reference is returned. A null name always creates a nameless work queue.
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_create(os_handle_t* h, size_t nWorkers, int8_t priority, uint32_t stack_size, char const * name){
+
+	/* Check for argument errors
+	 ------------------------------------------------------*/
+	if(h == NULL) 							return OS_ERR_BAD_ARG;
+	if(nWorkers == 0) 						return OS_ERR_BAD_ARG;
+	if(priority < 0) 						return OS_ERR_BAD_ARG;
+	if(stack_size < OS_MINIMUM_STACK_SIZE)	return OS_ERR_BAD_ARG;
+	if(os_init_get() == false)				return OS_ERR_NOT_READY;
+
+	/* If work queue exists, return it
+	 ------------------------------------------------------*/
+	if(name != NULL){
+		os_list_cell_t* obj = os_handle_list_searchByName(&os_obj_head, OS_OBJ_WORKQ, name);
+		if(obj != NULL){
+			*h = obj->element;
+			return OS_ERR_OK;
+		}
+	}
+
+	/* Alloc the work queue block
+	 ------------------------------------------------------*/
+	os_workq_t* q = (os_workq_t*)os_heap_alloc(sizeof(os_workq_t));
+
+	/* Check allocation
+	 ------------------------------------------------------*/
+	if(q == 0) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init work queue
+	 ------------------------------------------------------*/
+	q->obj.type 			= OS_OBJ_WORKQ;
+	q->obj.objUpdate 		= 0;
+	q->obj.getFreeCount		= os_workq_getFreeCount;
+	q->obj.obj_take 		= os_workq_objTake;
+	q->obj.blockList		= os_list_init();
+	q->obj.waitSet			= NULL;
+	q->obj.name				= name == NULL ? NULL : (char*)os_heap_alloc(strlen(name) + 1);
+
+	/* Finish init
+	 ------------------------------------------------------*/
+	q->queue				= NULL;
+	q->kick					= NULL;
+	q->delayedList			= os_list_init();
+	q->workers				= (os_handle_t*)os_heap_alloc(nWorkers * sizeof(os_handle_t));
+	q->nWorkers				= nWorkers;
+	q->busy					= 0;
+	q->stop					= false;
+
+	os_err_e ret = os_msgQ_create(&q->queue, OS_MSGQ_MODE_FIFO, NULL);
+	ret = ret == OS_ERR_OK ? os_evt_create(&q->kick, OS_EVT_MODE_AUTO, NULL) : ret;
+
+	/* Handles heap errors
+	 ------------------------------------------------------*/
+	if(q->obj.blockList == NULL || q->delayedList == NULL || q->workers == NULL || ret != OS_ERR_OK || (q->obj.name == NULL && name != NULL) ){
+		q->nWorkers = 0;
+		os_workq_free(q);
+
+		return OS_ERR_INSUFFICIENT_HEAP;
+	}
+
+	for(size_t i = 0; i < nWorkers; i++)
+		q->workers[i] = NULL;
+
+	/* Copy name
+	 ------------------------------------------------------*/
+	if(name != NULL)
+		strcpy(q->obj.name, name);
+
+	/* Add object to object list
+	 ------------------------------------------------------*/
+	ret = os_list_add(&os_obj_head, (os_handle_t) q, OS_LIST_FIRST);
+	if(ret != OS_ERR_OK) {
+		os_workq_free(q);
+		return ret;
+	}
+
+	/* Create the workers once the queue is usable
+	 ------------------------------------------------------*/
+	for(size_t i = 0; i < nWorkers; i++){
+		ret = os_task_create(&q->workers[i], NULL, os_workq_worker, OS_TASK_MODE_RETURN, priority, stack_size, q);
+		if(ret != OS_ERR_OK){
+			q->workers[i] = NULL;
+			os_list_remove(&os_obj_head, (os_handle_t) q);
+			os_workq_free(q);
+			return ret;
+		}
+	}
+
+	/* Return
+	 ------------------------------------------------------*/
+	*h = (os_handle_t)q;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Work Queue Submit
+ *
+ * @brief This function queues a function to be executed by a worker task
+ *
+ * @param os_handle_t h 		: [ in] Handle to the work queue
+ * @param void (*fn)(void*) 	: [ in] Function to execute
+ * @param void* arg 			: [ in] Argument passed to fn
+ * @param os_handle_t doneEvt 	: [ in] Event set once fn returned. NULL if none
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_submit(os_handle_t h, void (*fn)(void*), void* arg, os_handle_t doneEvt){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_workq_t* q = os_workq_getFromHandle(h);
+	if(q == NULL || fn == NULL) return OS_ERR_BAD_ARG;
+
+	/* Alloc work
+	 ------------------------------------------------------*/
+	os_work_t* work = os_workq_newWork(fn, arg, doneEvt, 0);
+	if(work == NULL) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Count it before a worker can finish it, then queue it
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	q->busy++;
+
+	os_err_e ret = os_msgQ_push(q->queue, work);
+	if(ret != OS_ERR_OK){
+		q->busy--;
+		os_heap_free(work);
+	}
+
+	OS_EXIT_CRITICAL();
+
+	return ret;
+}
+
+
+/***********************************************************************
+ * OS Work Queue Submit Delayed
+ *
+ * @brief This function queues a function to be executed by a worker task once a delay has elapsed
+ *
+ * @param os_handle_t h 		: [ in] Handle to the work queue
+ * @param void (*fn)(void*) 	: [ in] Function to execute
+ * @param void* arg 			: [ in] Argument passed to fn
+ * @param os_handle_t doneEvt 	: [ in] Event set once fn returned. NULL if none
+ * @param uint32_t delay_ms 	: [ in] Minimum amount of ms before the work is executed
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_submitDelayed(os_handle_t h, void (*fn)(void*), void* arg, os_handle_t doneEvt, uint32_t delay_ms){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_workq_t* q = os_workq_getFromHandle(h);
+	if(q == NULL || fn == NULL) return OS_ERR_BAD_ARG;
+	if(delay_ms >= 0x80000000UL) return OS_ERR_BAD_ARG;
+
+	if(delay_ms == 0) return os_workq_submit(h, fn, arg, doneEvt);
+
+	/* Alloc work. The deadline is kept in ms, the unit the task wait countdown is decremented in
+	 ------------------------------------------------------*/
+	os_work_t* work = os_workq_newWork(fn, arg, doneEvt, os_getMsTick() + delay_ms);
+	if(work == NULL) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Store it, then make a worker recompute its timeout
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	os_err_e ret = os_list_add(q->delayedList, work, OS_LIST_LAST);
+	if(ret != OS_ERR_OK){
+		OS_EXIT_CRITICAL();
+		os_heap_free(work);
+		return ret;
+	}
+
+	q->busy++;
+	os_evt_set(q->kick);
+
+	OS_EXIT_CRITICAL();
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS Work Queue delete
+ *
+ * @brief This function deletes a work queue and its workers. Works being executed are allowed to finish first,
+ * works not started yet are dropped. It must not be called by a worker nor if there is a task waiting for the work queue.
+ *
+ * @param os_handle_t h : [ in] Handle to the work queue
+ *
+ * @return os_err_e OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_workq_delete(os_handle_t h){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	os_workq_t* q = os_workq_getFromHandle(h);
+	if(q == NULL) return OS_ERR_BAD_ARG;
+
+	for(size_t i = 0; i < q->nWorkers; i++){
+		if(q->workers[i] == os_cur_task->element) return OS_ERR_FORBIDDEN;
+	}
+
+	/* Deletes from obj list and from its wait-set
+	 ------------------------------------------------------*/
+	os_list_remove(&os_obj_head, h);
+	os_waitset_detach(h);
+
+	/* Ask the workers to stop and wait for each of them to return, so none is killed in the middle of a work
+	 ------------------------------------------------------*/
+	q->stop = true;
+	os_evt_set(q->kick);
+
+	for(size_t i = 0; i < q->nWorkers; i++){
+		os_err_e err = OS_ERR_OK;
+		os_obj_single_wait(q->workers[i], OS_WAIT_FOREVER, &err);
+	}
+
+	/* Free workers and memory
+	 ------------------------------------------------------*/
+	OS_CRITICAL_SECTION(
+		os_workq_free(q);
+	);
+
+	return OS_ERR_OK;
+}
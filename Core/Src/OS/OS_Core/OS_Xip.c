@@ -0,0 +1,246 @@
+/*
+ * OS_Xip.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ */
+
+#include "common.h"
+#include "OS/OS_Core/OS.h"
+#include "OS/OS_Core/OS_Internal.h"
+#include "OS/OS_Core/OS_Xip.h"
+
+/**********************************************
+ * EXTERNAL VARIABLES
+ *********************************************/
+
+extern os_list_head_t os_process_list;	//Head of process list
+extern os_handle_t fsMutex;				//FS mutex, also serializes the flash driver
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS XIP align
+ *
+ * @brief This function aligns an address on OS_XIP_ALIGN
+ **********************************************************************/
+static inline uint32_t os_xip_align(uint32_t addr){
+	return (addr + OS_XIP_ALIGN - 1) & ~((uint32_t)OS_XIP_ALIGN - 1);
+}
+
+
+/***********************************************************************
+ * OS XIP text
+ *
+ * @brief This function gets the text address of an image
+ **********************************************************************/
+static inline uint32_t os_xip_text(os_xip_image_t const* img){
+	return (uint32_t)img + os_xip_align(sizeof(os_xip_image_t));
+}
+
+
+/***********************************************************************
+ * OS XIP next
+ *
+ * @brief This function gets the next image of the area
+ *
+ * @param os_xip_image_t const* img : [in] current image, NULL to get the first one
+ *
+ * @return os_xip_image_t const* : the next image header, that may be erased (end of list). NULL if the area is full
+ **********************************************************************/
+static os_xip_image_t const* os_xip_next(os_xip_image_t const* img){
+
+	uint32_t next = img == NULL ? OS_XIP_BASE_ADDR : os_xip_align(os_xip_text(img) + img->size);
+
+	if(next < OS_XIP_BASE_ADDR || next + sizeof(os_xip_image_t) > OS_XIP_END_ADDR) return NULL;
+
+	return (os_xip_image_t const*)next;
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+
+/***********************************************************************
+ * OS XIP hash
+ *
+ * @brief This function adds a block of data to a hash (FNV-1a). Start with OS_XIP_HASH_INIT
+ *
+ * @param uint32_t h 			: [in] Current hash
+ * @param void const* data 		: [in] Block to add
+ * @param size_t size 			: [in] Size of the block
+ *
+ * @return uint32_t : the new hash
+ **********************************************************************/
+uint32_t os_xip_hash(uint32_t h, void const* data, size_t size){
+
+	for(size_t i = 0; i < size; i++){
+		h ^= ((uint8_t const*)data)[i];
+		h *= 16777619UL;
+	}
+
+	return h;
+}
+
+
+/***********************************************************************
+ * OS XIP key
+ *
+ * @brief This function computes the key identifying an ELF build, from its header and program header table
+ *
+ * @param void const* header 	: [in] ELF header
+ * @param size_t headerSize 	: [in] Size of the ELF header
+ * @param void const* ph 		: [in] Program header table
+ * @param size_t phSize 		: [in] Size of the program header table
+ *
+ * @return uint32_t : the key
+ **********************************************************************/
+uint32_t os_xip_key(void const* header, size_t headerSize, void const* ph, size_t phSize){
+	return os_xip_hash(os_xip_hash(OS_XIP_HASH_INIT, header, headerSize), ph, phSize);
+}
+
+
+/***********************************************************************
+ * OS XIP find
+ *
+ * @brief This function searches the installed text of an ELF file
+ *
+ * @param char const* name 	: [in] Name of the ELF file
+ * @param uint32_t key 		: [in] Key of the ELF build
+ * @param uint32_t size 	: [in] Size of the text
+ *
+ * @return uint8_t const* : address of the text in flash, NULL if the file is not installed or was modified since
+ **********************************************************************/
+uint8_t const* os_xip_find(char const* name, uint32_t key, uint32_t size){
+
+	if(name == NULL) return NULL;
+
+	/* Flash is memory mapped, walk the headers in place
+	 ------------------------------------------------------*/
+	for(os_xip_image_t const* img = os_xip_next(NULL); img != NULL && img->size != 0xFFFFFFFFUL; img = os_xip_next(img)){
+		if(img->magic != OS_XIP_MAGIC) continue;
+		if(img->key != key || img->size != size) continue;
+		if(strncmp(img->name, name, OS_XIP_NAME_LEN - 1) != 0) continue;
+
+		return (uint8_t const*)os_xip_text(img);
+	}
+
+	return NULL;
+}
+
+
+/***********************************************************************
+ * OS XIP reserve
+ *
+ * @brief This function reserves room for a new image at the end of the area and writes its header. The image stays invalid until os_xip_commit.
+ * Must be called with the FS mutex held
+ *
+ * @param char const* name 	: [ in] Name of the ELF file
+ * @param uint32_t key 		: [ in] Key of the ELF build
+ * @param uint32_t size 	: [ in] Size of the text
+ * @param uint32_t* addr 	: [out] Flash address where the text must be written
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_INVALID if there is no room left (os_xip_clear must be called)
+ **********************************************************************/
+os_err_e os_xip_reserve(char const* name, uint32_t key, uint32_t size, uint32_t* addr){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(name == NULL || addr == NULL || size == 0 || size == 0xFFFFFFFFUL) return OS_ERR_BAD_ARG;
+
+	/* Go to the end of the list
+	 ------------------------------------------------------*/
+	os_xip_image_t const* img = os_xip_next(NULL);
+	while(img != NULL && img->size != 0xFFFFFFFFUL)
+		img = os_xip_next(img);
+
+	if(img == NULL || os_xip_text(img) + size > OS_XIP_END_ADDR) return OS_ERR_INVALID;
+
+	/* Write header, keeping the magic erased
+	 ------------------------------------------------------*/
+	os_xip_image_t hdr;
+	memset(&hdr, 0, sizeof(hdr));
+
+	hdr.magic 	= 0xFFFFFFFFUL;
+	hdr.size 	= size;
+	hdr.key 	= key;
+	strncpy(hdr.name, name, OS_XIP_NAME_LEN - 1);
+
+	if(os_flash_write((uint32_t)img, (uint8_t*)&hdr, sizeof(hdr)) < 0) return OS_ERR_UNKNOWN;
+
+	*addr = os_xip_text(img);
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS XIP commit
+ *
+ * @brief This function validates an image whose text was written, and invalidates older images of the same file.
+ * Must be called with the FS mutex held
+ *
+ * @param uint32_t addr : [in] Text address returned by os_xip_reserve
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_xip_commit(uint32_t addr){
+
+	os_xip_image_t const* newImg = (os_xip_image_t const*)(addr - os_xip_align(sizeof(os_xip_image_t)));
+	if((uint32_t)newImg < OS_XIP_BASE_ADDR || addr >= OS_XIP_END_ADDR) return OS_ERR_BAD_ARG;
+
+	/* Invalidate older images of the same file (clearing bits needs no erase)
+	 ------------------------------------------------------*/
+	uint32_t dead = 0;
+	for(os_xip_image_t const* img = os_xip_next(NULL); img != NULL && img != newImg && img->size != 0xFFFFFFFFUL; img = os_xip_next(img)){
+		if(img->magic != OS_XIP_MAGIC) continue;
+		if(strncmp(img->name, newImg->name, OS_XIP_NAME_LEN) != 0) continue;
+
+		if(os_flash_write((uint32_t)&img->magic, (uint8_t*)&dead, sizeof(dead)) < 0) return OS_ERR_UNKNOWN;
+	}
+
+	/* Validate new image
+	 ------------------------------------------------------*/
+	uint32_t magic = OS_XIP_MAGIC;
+	if(os_flash_write((uint32_t)&newImg->magic, (uint8_t*)&magic, sizeof(magic)) < 0) return OS_ERR_UNKNOWN;
+
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS XIP clear
+ *
+ * @brief This function erases every installed image. It fails while a process runs from the area.
+ * The FS mutex is held meanwhile: lfs shares the flash driver, and loads hold it until their process is registered
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_FORBIDDEN if a process uses the area
+ **********************************************************************/
+os_err_e os_xip_clear(){
+
+	/* Get FS mutex
+	 ------------------------------------------------------*/
+	os_err_e ret = OS_ERR_OK;
+	os_obj_single_wait(fsMutex, OS_WAIT_FOREVER, &ret);
+	if(ret != OS_ERR_OK)
+		return ret;
+
+	/* Check no process executes from the area
+	 ------------------------------------------------------*/
+	for(os_list_cell_t* it = os_process_list.head.next; it != NULL; it = it->next){
+		if(((os_process_t*)it->element)->text != NULL){
+			os_mutex_release(fsMutex);
+			return OS_ERR_FORBIDDEN;
+		}
+	}
+
+	/* Erase
+	 ------------------------------------------------------*/
+	ret = os_flash_erase(OS_XIP_BASE_ADDR, (OS_XIP_END_ADDR - OS_XIP_BASE_ADDR) / OS_XIP_SECTOR_SIZE);
+
+	os_mutex_release(fsMutex);
+
+	return ret < 0 ? ret : OS_ERR_OK;
+}
@@ -18,34 +18,26 @@
 extern os_handle_t fsMutex;
 
 /**********************************************
- * PUBLIC FUNCTIONS
+ * PRIVATE VARIABLES
+ *********************************************/
+
+static os_handle_t os_fs_ringWorkQ = NULL;	//Work queue executing the I/O ring batches
+
+/**********************************************
+ * PRIVATE FUNCTIONS
  *********************************************/
 
 /***********************************************************************
- * OS File open
+ * OS File open (FS mutex held)
  *
- * @brief This function opens a file using its name
+ * @brief This function opens a file using its name. The caller must own the FS mutex
  *
  * @param char* filename : [in] This is the C string containing the name of the file to be opened.
  * @param char* mode 	 : [in] This is the C string containing a file access mode.
  *
- * File modes  :
- * 		- "r"  : Opens a file for reading. The file must exist.
- * 		- "w"  : Creates an empty file for writing. If a file with the same name already exists, its content is erased and the file is considered as a new empty file.
- * 		- "a"  : Appends to a file. Writing operations, append data at the end of the file. The file is created if it does not exist.
- * 		- "r+" : Opens a file to update both reading and writing. The file must exist.
- * 		- "w+" : Creates an empty file for both reading and writing.
- * 		- "a+" : Opens a file for reading and appending.
- *
  * @return OS_FILE* : file pointer or NULL if error
  **********************************************************************/
-OS_FILE* os_fopen(const char* filename, const char* mode){
-
-	/* Check arguments
-	 ------------------------------------------------------*/
-	if(mode == NULL) return NULL;
-	if(filename == NULL) return NULL;
-	if(strlen(mode) > 2) return NULL;
+static OS_FILE* os_fs_fopenLocked(const char* filename, const char* mode){
 
 	/* Define flags
 	 ------------------------------------------------------*/
@@ -64,11 +56,6 @@ OS_FILE* os_fopen(const char* filename, const char* mode){
 		return NULL;
 	}
 
-	/* Get FS mutex
-	 ------------------------------------------------------*/
-	if(os_obj_single_wait(fsMutex, OS_WAIT_FOREVER, NULL) == NULL)
-		return NULL;
-
 	/* Allocate file pointer
 	 ------------------------------------------------------*/
 	OS_FILE* f = os_heap_alloc(sizeof(lfs_file_t));
@@ -83,6 +70,192 @@ OS_FILE* os_fopen(const char* filename, const char* mode){
 		return NULL;
 	}
 
+	return f;
+}
+
+
+/***********************************************************************
+ * OS File close (FS mutex held)
+ *
+ * @brief This function closes an opened file and frees its pointer. The caller must own the FS mutex
+ *
+ * @param OS_FILE* fstream	: [in] The file pointer to close
+ *
+ * @return int : 0 if success
+ **********************************************************************/
+static int os_fs_fcloseLocked(OS_FILE* fstream){
+
+	/* Close file
+	 ------------------------------------------------------*/
+	int fserr = lfs_file_close(&lfs, (lfs_file_t*) fstream);
+
+	/* Free file pointer
+	 ------------------------------------------------------*/
+	os_err_e errh = os_heap_free(fstream);
+	if(errh != OS_ERR_OK)
+		return errh;
+
+	/* Return 0 if OK
+	 ------------------------------------------------------*/
+	return fserr < 0 ? OS_ERR_FS : 0;
+}
+
+
+/***********************************************************************
+ * OS File Read (FS mutex held)
+ *
+ * @brief This function reads from an opened file. The caller must own the FS mutex
+ *
+ * @return size_t : number of elements read
+ **********************************************************************/
+static size_t os_fs_freadLocked(void* ptr, size_t size, size_t nmemb, OS_FILE* fstream){
+	int fserr = lfs_file_read(&lfs, (lfs_file_t*)fstream, ptr, size * nmemb);
+	return (fserr < 0) ? 0 : ((size_t)fserr / (size_t)size);
+}
+
+
+/***********************************************************************
+ * OS File Write (FS mutex held)
+ *
+ * @brief This function writes to an opened file. The caller must own the FS mutex
+ *
+ * @return size_t : number of elements written
+ **********************************************************************/
+static size_t os_fs_fwriteLocked(const void* ptr, size_t size, size_t count, OS_FILE* fstream){
+	int fserr = lfs_file_write(&lfs, (lfs_file_t*)fstream, ptr, size * count);
+	return (fserr < 0) ? 0 : ((size_t)fserr / (size_t)size);
+}
+
+
+/***********************************************************************
+ * OS File Ring Execute One
+ *
+ * @brief This function executes one submission entry. The caller must own the FS mutex
+ *
+ * @param os_fs_sqe_t* sqe : [in] Entry to execute
+ *
+ * @return int32_t : the value returned by the matching os_f* function
+ **********************************************************************/
+static int32_t os_fs_ring_executeOne(os_fs_sqe_t* sqe){
+
+	switch(sqe->op){
+		case OS_SYSCALL_FOPEN :
+			if(sqe->arg[0] == 0 || sqe->arg[1] == 0 || strlen((char*)sqe->arg[1]) > 2) return 0;
+			return (int32_t)os_fs_fopenLocked((char*)sqe->arg[0], (char*)sqe->arg[1]);
+
+		case OS_SYSCALL_FCLOSE :
+			if(sqe->arg[0] == 0) return OS_ERR_BAD_ARG;
+			return os_fs_fcloseLocked((OS_FILE*)sqe->arg[0]);
+
+		case OS_SYSCALL_FREAD :
+			if(sqe->arg[0] == 0 || sqe->arg[1] == 0 || sqe->arg[2] == 0 || sqe->arg[3] == 0) return 0;
+			return (int32_t)os_fs_freadLocked((void*)sqe->arg[0], (size_t)sqe->arg[1], (size_t)sqe->arg[2], (OS_FILE*)sqe->arg[3]);
+
+		case OS_SYSCALL_FWRITE :
+			if(sqe->arg[0] == 0 || sqe->arg[1] == 0 || sqe->arg[2] == 0 || sqe->arg[3] == 0) return 0;
+			return (int32_t)os_fs_fwriteLocked((void*)sqe->arg[0], (size_t)sqe->arg[1], (size_t)sqe->arg[2], (OS_FILE*)sqe->arg[3]);
+
+		default :
+			return OS_ERR_INVALID;
+	}
+}
+
+
+/***********************************************************************
+ * OS File Ring Execute
+ *
+ * @brief Work queue function. Executes every submitted entry of a ring under a single FS lock, posts the completions
+ * and notifies the process once per batch. Loops until no entry is left, so a single notification covers entries submitted meanwhile.
+ *
+ * @param void* arg : [in] Reference to the ring
+ **********************************************************************/
+static void os_fs_ring_execute(void* arg){
+
+	os_fs_ring_t* ring = (os_fs_ring_t*)arg;
+	uint32_t mask = ring->size - 1;
+
+	while(1){
+
+		/* Disarm once there is nothing left, atomically with os_fs_ring_submit
+		 ------------------------------------------------------*/
+		OS_DECLARE_IRQ_STATE;
+		OS_ENTER_CRITICAL();
+
+		if(ring->sq_head == ring->sq_tail){
+			ring->armed = false;
+			OS_EXIT_CRITICAL();
+			return;
+		}
+
+		OS_EXIT_CRITICAL();
+
+		/* Get FS mutex once for the whole batch
+		 ------------------------------------------------------*/
+		os_err_e err = OS_ERR_OK;
+		os_obj_single_wait(fsMutex, OS_WAIT_FOREVER, &err);
+
+		/* Execute entries. There is always room in the completion ring, os_fs_ring_getSqe reserves it
+		 ------------------------------------------------------*/
+		uint32_t tail = ring->sq_tail;
+		while(ring->sq_head != tail){
+			os_fs_sqe_t* sqe = &ring->sq[ring->sq_head & mask];
+			os_fs_cqe_t* cqe = &ring->cq[ring->cq_tail & mask];
+
+			cqe->user_data 	= sqe->user_data;
+			cqe->res 		= err == OS_ERR_OK ? os_fs_ring_executeOne(sqe) : (int32_t)err;
+
+			ring->cq_tail++;
+			ring->sq_head++;
+		}
+
+		/* Release mutex and notify process
+		 ------------------------------------------------------*/
+		if(err == OS_ERR_OK)
+			os_mutex_release(fsMutex);
+
+		os_evt_set(ring->cqEvt);
+	}
+}
+
+/**********************************************
+ * PUBLIC FUNCTIONS
+ *********************************************/
+
+/***********************************************************************
+ * OS File open
+ *
+ * @brief This function opens a file using its name
+ *
+ * @param char* filename : [in] This is the C string containing the name of the file to be opened.
+ * @param char* mode 	 : [in] This is the C string containing a file access mode.
+ *
+ * File modes  :
+ * 		- "r"  : Opens a file for reading. The file must exist.
+ * 		- "w"  : Creates an empty file for writing. If a file with the same name already exists, its content is erased and the file is considered as a new empty file.
+ * 		- "a"  : Appends to a file. Writing operations, append data at the end of the file. The file is created if it does not exist.
+ * 		- "r+" : Opens a file to update both reading and writing. The file must exist.
+ * 		- "w+" : Creates an empty file for both reading and writing.
+ * 		- "a+" : Opens a file for reading and appending.
+ *
+ * @return OS_FILE* : file pointer or NULL if error
+ **********************************************************************/
+OS_FILE* os_fopen(const char* filename, const char* mode){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(mode == NULL) return NULL;
+	if(filename == NULL) return NULL;
+	if(strlen(mode) > 2) return NULL;
+
+	/* Get FS mutex
+	 ------------------------------------------------------*/
+	if(os_obj_single_wait(fsMutex, OS_WAIT_FOREVER, NULL) == NULL)
+		return NULL;
+
+	/* Open file
+	 ------------------------------------------------------*/
+	OS_FILE* f = os_fs_fopenLocked(filename, mode);
+
 	/* Release mutex
 	 ------------------------------------------------------*/
 	if(os_mutex_release(fsMutex) != OS_ERR_OK){
@@ -119,29 +292,20 @@ int os_fclose(OS_FILE* fstream){
 
 	/* Close file
 	 ------------------------------------------------------*/
-	int fserr = lfs_file_close(&lfs, (lfs_file_t*) fstream);
+	int fserr = os_fs_fcloseLocked(fstream);
 
 	/* Release mutex
 	 ------------------------------------------------------*/
 	err = os_mutex_release(fsMutex);
 
-	/* Free file pointer
-	 ------------------------------------------------------*/
-	os_err_e errh = os_heap_free(fstream);
-
 	/* Return error
 	 ------------------------------------------------------*/
 	if(err != OS_ERR_OK)
 		return err;
 
-	/* Return error
-	 ------------------------------------------------------*/
-	if(errh != OS_ERR_OK)
-		return errh;
-
 	/* Return 0 if OK
 	 ------------------------------------------------------*/
-	return fserr < 0 ? OS_ERR_FS : 0;
+	return fserr;
 }
 
 
@@ -173,7 +337,7 @@ size_t os_fread(void* ptr, size_t size, size_t nmemb, OS_FILE* fstream){
 
 	/* read file
 	 ------------------------------------------------------*/
-	int fserr = lfs_file_read(&lfs, (lfs_file_t*)fstream, ptr, size * nmemb);
+	size_t ret = os_fs_freadLocked(ptr, size, nmemb, fstream);
 
 	/* Release mutex
 	 ------------------------------------------------------*/
@@ -181,7 +345,7 @@ size_t os_fread(void* ptr, size_t size, size_t nmemb, OS_FILE* fstream){
 	if(err != OS_ERR_OK)
 		return 0;
 
-	return (fserr < 0) ? 0 : ((size_t)fserr / (size_t)size);
+	return ret;
 }
 
 
@@ -213,7 +377,7 @@ size_t os_fwrite(const void * ptr, size_t size, size_t count, OS_FILE * fstream)
 
 	/* write file
 	 ------------------------------------------------------*/
-	int fserr = lfs_file_write(&lfs, (lfs_file_t*)fstream, ptr, size * count);
+	size_t ret = os_fs_fwriteLocked(ptr, size, count, fstream);
 
 	/* Release mutex
 	 ------------------------------------------------------*/
@@ -221,7 +385,7 @@ size_t os_fwrite(const void * ptr, size_t size, size_t count, OS_FILE * fstream)
 	if(err != OS_ERR_OK)
 		return 0;
 
-	return fserr < 0 ? 0 : ((size_t)fserr / (size_t)size);
+	return ret;
 }
 
 
@@ -276,3 +440,238 @@ int os_fseek(OS_FILE *fstream, int32_t offset, os_fs_seek_e whence){
 	 ------------------------------------------------------*/
 	return fserr < 0 ? OS_ERR_FS : 0;
 }
+
+
+/***********************************************************************
+ * OS File Ring Create
+ *
+ * @brief This function creates a pair of submission and completion rings, shared between the caller and the kernel.
+ * Operations queued in the submission ring are executed in batches by a kernel worker, under a single FS lock.
+ *
+ * @param os_fs_ring_t** ring 	: [out] Reference to the ring
+ * @param uint32_t size 		: [ in] Number of entries of each ring. Must be a power of 2
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_fs_ring_create(os_fs_ring_t** ring, uint32_t size){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(ring == NULL) return OS_ERR_BAD_ARG;
+	if(size == 0 || (size & (size - 1)) != 0) return OS_ERR_BAD_ARG;
+
+	/* Create the kernel worker on first use. Critical so two callers cannot both create it
+	 ------------------------------------------------------*/
+	os_err_e qErr = OS_ERR_OK;
+	OS_CRITICAL_SECTION(
+		if(os_fs_ringWorkQ == NULL)
+			qErr = os_workq_create(&os_fs_ringWorkQ, 1, OS_FS_RING_WORKER_PRIO, OS_FS_RING_WORKER_STACK_SIZE, "fs ring");
+	);
+	if(qErr != OS_ERR_OK) return qErr;
+
+	/* Alloc ring and both entry arrays in one block
+	 ------------------------------------------------------*/
+	os_fs_ring_t* r = (os_fs_ring_t*)os_heap_alloc(sizeof(os_fs_ring_t) + size * (sizeof(os_fs_sqe_t) + sizeof(os_fs_cqe_t)));
+	if(r == NULL) return OS_ERR_INSUFFICIENT_HEAP;
+
+	/* Init ring
+	 ------------------------------------------------------*/
+	r->size 	= size;
+	r->sq_prep 	= 0;
+	r->sq_head 	= 0;
+	r->sq_tail 	= 0;
+	r->cq_head 	= 0;
+	r->cq_tail 	= 0;
+	r->armed 	= false;
+	r->sq 		= (os_fs_sqe_t*)(r + 1);
+	r->cq 		= (os_fs_cqe_t*)(r->sq + size);
+	r->cqEvt 	= NULL;
+
+	os_err_e err = os_evt_create(&r->cqEvt, OS_EVT_MODE_AUTO, NULL);
+	if(err != OS_ERR_OK){
+		os_heap_free(r);
+		return err;
+	}
+
+	*ring = r;
+	return OS_ERR_OK;
+}
+
+
+/***********************************************************************
+ * OS File Ring Get Submission Entry
+ *
+ * @brief This function returns the next free submission entry. The entry is only seen by the kernel after os_fs_ring_submit.
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_fs_sqe_t* : the entry to fill, NULL if every entry is in use (submitted or waiting to be consumed as a completion)
+ **********************************************************************/
+os_fs_sqe_t* os_fs_ring_getSqe(os_fs_ring_t* ring){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(ring == NULL) return NULL;
+
+	/* Every entry not consumed as a completion yet keeps its slot, so the completion ring never overflows
+	 ------------------------------------------------------*/
+	if(ring->sq_prep - ring->cq_head >= ring->size) return NULL;
+
+	return &ring->sq[ring->sq_prep++ & (ring->size - 1)];
+}
+
+
+/***********************************************************************
+ * OS File Ring Submit
+ *
+ * @brief This function hands every entry obtained with os_fs_ring_getSqe to the kernel, and notifies the worker once
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_err_e : OS_ERR_OK if OK
+ **********************************************************************/
+os_err_e os_fs_ring_submit(os_fs_ring_t* ring){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(ring == NULL) return OS_ERR_BAD_ARG;
+
+	/* Publish entries and claim the ring if the worker is not already on it
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	ring->sq_tail = ring->sq_prep;
+
+	bool arm = ring->armed == false && ring->sq_head != ring->sq_tail;
+	if(arm) ring->armed = true;
+
+	OS_EXIT_CRITICAL();
+
+	if(arm == false) return OS_ERR_OK;
+
+	/* Queue a batch outside the critical section, submitting allocates from the heap
+	 ------------------------------------------------------*/
+	os_err_e err = os_workq_submit(os_fs_ringWorkQ, os_fs_ring_execute, ring, NULL);
+	if(err != OS_ERR_OK){
+		OS_CRITICAL_SECTION(
+			ring->armed = false;
+		);
+	}
+
+	return err;
+}
+
+
+/***********************************************************************
+ * OS File Ring Peek Completion
+ *
+ * @brief This function returns the oldest completion entry not consumed, without waiting
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_fs_cqe_t* : the completion entry, NULL if there is none
+ **********************************************************************/
+os_fs_cqe_t* os_fs_ring_peekCqe(os_fs_ring_t* ring){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(ring == NULL) return NULL;
+	if(ring->cq_head == ring->cq_tail) return NULL;
+
+	return &ring->cq[ring->cq_head & (ring->size - 1)];
+}
+
+
+/***********************************************************************
+ * OS File Ring Wait Completion
+ *
+ * @brief This function returns the oldest completion entry not consumed, waiting for one if needed
+ *
+ * @param os_fs_ring_t* ring 		: [in] Reference to the ring
+ * @param uint32_t timeout_ms 	: [in] Amount of ms to wait. OS_WAIT_FOREVER is accepted
+ *
+ * @return os_fs_cqe_t* : the completion entry, NULL if none was posted in time
+ **********************************************************************/
+os_fs_cqe_t* os_fs_ring_waitCqe(os_fs_ring_t* ring, uint32_t timeout_ms){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(ring == NULL) return NULL;
+
+	uint32_t start = os_getMsTick();
+
+	/* The event may be left set by a batch already consumed, so check again after every wake up
+	 ------------------------------------------------------*/
+	os_fs_cqe_t* cqe = os_fs_ring_peekCqe(ring);
+	while(cqe == NULL){
+
+		/* Compute the time left. Everything is in ms, the unit the task wait countdown is decremented in
+		 ------------------------------------------------------*/
+		uint32_t left = timeout_ms;
+		if(timeout_ms != OS_WAIT_FOREVER){
+			uint32_t elapsed = os_getMsTick() - start;
+			if(elapsed >= timeout_ms) return NULL;
+			left = timeout_ms - elapsed;
+		}
+
+		/* Wait for a batch to finish
+		 ------------------------------------------------------*/
+		os_err_e err = OS_ERR_OK;
+		os_obj_single_wait(ring->cqEvt, left, &err);
+		if(err != OS_ERR_OK) return os_fs_ring_peekCqe(ring);
+
+		cqe = os_fs_ring_peekCqe(ring);
+	}
+
+	return cqe;
+}
+
+
+/***********************************************************************
+ * OS File Ring Completion Seen
+ *
+ * @brief This function consumes the completion entry returned by os_fs_ring_peekCqe or os_fs_ring_waitCqe, freeing its slot
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ **********************************************************************/
+void os_fs_ring_cqeSeen(os_fs_ring_t* ring){
+	if(ring == NULL) return;
+	if(ring->cq_head == ring->cq_tail) return;
+
+	ring->cq_head++;
+}
+
+
+/***********************************************************************
+ * OS File Ring Delete
+ *
+ * @brief This function deletes a ring. It fails while the kernel still executes a batch of it.
+ *
+ * @param os_fs_ring_t* ring : [in] Reference to the ring
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_FORBIDDEN if a batch is in progress
+ **********************************************************************/
+os_err_e os_fs_ring_delete(os_fs_ring_t* ring){
+
+	/* Check arguments
+	 ------------------------------------------------------*/
+	if(ring == NULL) return OS_ERR_BAD_ARG;
+
+	/* Read the batch state under the same guard as the worker
+	 ------------------------------------------------------*/
+	OS_DECLARE_IRQ_STATE;
+	OS_ENTER_CRITICAL();
+
+	bool armed = ring->armed;
+
+	OS_EXIT_CRITICAL();
+
+	if(armed) return OS_ERR_FORBIDDEN;
+
+	/* Free memory
+	 ------------------------------------------------------*/
+	os_evt_delete(ring->cqEvt);
+
+	return os_heap_free(ring);
+}
@@ -34,24 +34,58 @@ const os_fn_link_table_el_t os_link_table[] = {
 		/* Heap
 		 ---------------------------------------------------*/
 		OS_LINK_FN("os_heap_clear", 			os_heap_clear),
-		OS_LINK_FN("os_heap_alloc", 			os_heap_alloc),
-		OS_LINK_FN("os_heap_free", 				os_heap_free),
+		OS_LINK_FN("os_heap_alloc", 			os_process_heapAlloc),
+		OS_LINK_FN("os_heap_free", 				os_process_heapFree),
 		OS_LINK_FN("os_heap_monitor", 			os_heap_monitor),
 
+		/* Mailbox
+		 ---------------------------------------------------*/
+		OS_LINK_FN("os_mbox_create",		 	os_mbox_create),
+		OS_LINK_FN("os_mbox_post", 				os_mbox_post),
+		OS_LINK_FN("os_mbox_read", 				os_mbox_read),
+		OS_LINK_FN("os_mbox_peek", 				os_mbox_peek),
+		OS_LINK_FN("os_mbox_delete", 			os_mbox_delete),
+
 		/* Message queue
 		 ---------------------------------------------------*/
 		OS_LINK_FN("os_msgQ_create",		 	os_msgQ_create),
 		OS_LINK_FN("os_msgQ_push", 				os_msgQ_push),
+		OS_LINK_FN("os_msgQ_push_prio", 			os_msgQ_push_prio),
 		OS_LINK_FN("os_msgQ_delete", 			os_msgQ_delete),
 		OS_LINK_FN("os_msgQ_getNumberOfMsgs", 	os_msgQ_getNumberOfMsgs),
 
 		/* Mutex
 		 ---------------------------------------------------*/
 		OS_LINK_FN("os_mutex_create", 			os_mutex_create),
+		OS_LINK_FN("os_mutex_create_ceiling", 	os_mutex_create_ceiling),
 		OS_LINK_FN("os_mutex_release", 			os_mutex_release),
 		OS_LINK_FN("os_mutex_delete", 			os_mutex_delete),
 		OS_LINK_FN("os_mutex_getState", 		os_mutex_getState),
 
+		/* Reader-writer lock
+		 ---------------------------------------------------*/
+		OS_LINK_FN("os_rwlock_create", 			os_rwlock_create),
+		OS_LINK_FN("os_rwlock_readLock", 		os_rwlock_readLock),
+		OS_LINK_FN("os_rwlock_writeLock", 		os_rwlock_writeLock),
+		OS_LINK_FN("os_rwlock_readUnlock", 		os_rwlock_readUnlock),
+		OS_LINK_FN("os_rwlock_writeUnlock", 	os_rwlock_writeUnlock),
+		OS_LINK_FN("os_rwlock_delete", 			os_rwlock_delete),
+
+		/* Condition variable
+		 ---------------------------------------------------*/
+		OS_LINK_FN("os_cond_create", 			os_cond_create),
+		OS_LINK_FN("os_cond_wait", 				os_cond_wait),
+		OS_LINK_FN("os_cond_signal", 			os_cond_signal),
+		OS_LINK_FN("os_cond_broadcast", 		os_cond_broadcast),
+		OS_LINK_FN("os_cond_delete", 			os_cond_delete),
+
+		/* Work queue
+		 ---------------------------------------------------*/
+		OS_LINK_FN("os_workq_create", 			os_workq_create),
+		OS_LINK_FN("os_workq_submit", 			os_workq_submit),
+		OS_LINK_FN("os_workq_submitDelayed", 	os_workq_submitDelayed),
+		OS_LINK_FN("os_workq_delete", 			os_workq_delete),
+
 		/* Wait
 		 ---------------------------------------------------*/
 		OS_LINK_FN("os_obj_single_wait", 		os_obj_single_wait),
@@ -62,10 +96,20 @@ const os_fn_link_table_el_t os_link_table[] = {
 		OS_LINK_FN("os_obj_multiple_vWaitAll", 	os_obj_multiple_vWaitAll),
 		OS_LINK_FN("os_obj_multiple_vWaitOne", 	os_obj_multiple_vWaitOne),
 
+		/* Wait-set
+		 ---------------------------------------------------*/
+		OS_LINK_FN("os_waitset_create", 		os_waitset_create),
+		OS_LINK_FN("os_waitset_add", 			os_waitset_add),
+		OS_LINK_FN("os_waitset_remove", 		os_waitset_remove),
+		OS_LINK_FN("os_waitset_wait", 			os_waitset_wait),
+		OS_LINK_FN("os_waitset_delete", 		os_waitset_delete),
+
 		/* Scheduler
 		 ---------------------------------------------------*/
 		OS_LINK_FN("os_scheduler_start", 		os_scheduler_start),
 		OS_LINK_FN("os_scheduler_stop", 		os_scheduler_stop),
+		OS_LINK_FN("os_scheduler_lock", 		os_scheduler_lock),
+		OS_LINK_FN("os_scheduler_unlock", 		os_scheduler_unlock),
 		OS_LINK_FN("os_scheduler_state_get", 	os_scheduler_state_get),
 
 		/* Semaphore
@@ -75,9 +119,19 @@ const os_fn_link_table_el_t os_link_table[] = {
 		OS_LINK_FN("os_sem_delete",				os_sem_delete),
 		OS_LINK_FN("os_sem_getCount", 			os_sem_getCount),
 
+		/* Stream
+		 ---------------------------------------------------*/
+		OS_LINK_FN("os_stream_create", 			os_stream_create),
+		OS_LINK_FN("os_stream_write", 			os_stream_write),
+		OS_LINK_FN("os_stream_read", 			os_stream_read),
+		OS_LINK_FN("os_stream_reset", 			os_stream_reset),
+		OS_LINK_FN("os_stream_getCount", 		os_stream_getCount),
+		OS_LINK_FN("os_stream_delete", 			os_stream_delete),
+
 		/* Tick
 		 ---------------------------------------------------*/
 		OS_LINK_FN("os_getMsTick", 				os_getMsTick),
+		OS_LINK_FN("os_kdata_get", 				os_kdata_get),
 
 		/* Tasks
 		 ---------------------------------------------------*/
@@ -85,6 +139,7 @@ const os_fn_link_table_el_t os_link_table[] = {
 		OS_LINK_FN("os_task_end", 				os_task_end),
 		OS_LINK_FN("os_task_return", 			os_task_return),
 		OS_LINK_FN("os_task_delete", 			os_task_delete),
+		OS_LINK_FN("os_task_reap", 				os_task_reap),
 		OS_LINK_FN("os_task_yeild", 			os_task_yeild),
 		OS_LINK_FN("os_task_getPrio", 			os_task_getPrio),
 		OS_LINK_FN("os_task_sleep", 			os_task_sleep),
@@ -104,6 +159,13 @@ const os_fn_link_table_el_t os_link_table[] = {
 		OS_LINK_FN("os_fread", 					os_fread),
 		OS_LINK_FN("os_fwrite", 				os_fwrite),
 		OS_LINK_FN("os_fseek", 					os_fseek),
+		OS_LINK_FN("os_fs_ring_create", 		os_fs_ring_create),
+		OS_LINK_FN("os_fs_ring_getSqe", 		os_fs_ring_getSqe),
+		OS_LINK_FN("os_fs_ring_submit", 		os_fs_ring_submit),
+		OS_LINK_FN("os_fs_ring_peekCqe", 		os_fs_ring_peekCqe),
+		OS_LINK_FN("os_fs_ring_waitCqe", 		os_fs_ring_waitCqe),
+		OS_LINK_FN("os_fs_ring_cqeSeen", 		os_fs_ring_cqeSeen),
+		OS_LINK_FN("os_fs_ring_delete", 		os_fs_ring_delete),
 };
 
 
@@ -8,22 +8,93 @@
 #include "OS/OS_Core/OS_Common.h"
 #include "common.h"
 
+/**********************************************
+ * DEFINES
+ *********************************************/
+
+#define OS_SL_INDEX_SIZE		256			//Number of slots of the hash index (power of 2, at least twice the link table size)
+#define OS_SL_INDEX_EMPTY		0xFFFF		//Marks a free slot
+
 /**********************************************
  * EXTERNAL FUNCTIONS
  *********************************************/
 
 extern const os_fn_link_table_el_t os_link_table[];
 
+/**********************************************
+ * PRIVATE VARIABLES
+ *********************************************/
+
+static uint16_t os_sl_index[OS_SL_INDEX_SIZE];	//Open addressing hash index of os_link_table, built by os_sl_init
+static bool os_sl_indexReady = false;			//Indicates if the index was built
+
 /**********************************************
  * PRIVATE FUNCTIONS
  *********************************************/
 
 static void*  __used pOs_sl_translate = &os_sl_translate;
 
+/***********************************************************************
+ * OS shared library hash
+ *
+ * @brief This function computes the FNV-1a hash of a symbol name
+ *
+ * @param char const* name : [in] symbol name
+ *
+ * @return uint32_t : the hash
+ **********************************************************************/
+static uint32_t os_sl_hash(char const* name){
+	uint32_t h = 2166136261UL;
+
+	while(*name != '\0'){
+		h ^= (uint8_t)*name++;
+		h *= 16777619UL;
+	}
+
+	return h;
+}
+
 /**********************************************
  * PUBLIC FUNCTIONS
  *********************************************/
 
+/***********************************************************************
+ * OS shared library init
+ *
+ * @brief This function builds the hash index used by os_sl_translate. Must be called once before loading any process
+ *
+ * @return os_err_e : OS_ERR_OK if OK, OS_ERR_INVALID if the link table is too big or has a duplicated name
+ **********************************************************************/
+os_err_e os_sl_init(){
+
+	/* Check size
+	 ------------------------------------------------------*/
+	size_t size = os_sl_linkTable_getSize();
+	if(size * 2 > OS_SL_INDEX_SIZE) return OS_ERR_INVALID;
+
+	/* Clear index
+	 ------------------------------------------------------*/
+	for(size_t i = 0; i < OS_SL_INDEX_SIZE; i++)
+		os_sl_index[i] = OS_SL_INDEX_EMPTY;
+
+	/* Insert every function in the first free slot after its hash
+	 ------------------------------------------------------*/
+	for(size_t i = 0; i < size; i++){
+		uint32_t slot = os_sl_hash(os_link_table[i].name) & (OS_SL_INDEX_SIZE - 1);
+
+		while(os_sl_index[slot] != OS_SL_INDEX_EMPTY){
+			if(strcmp(os_link_table[os_sl_index[slot]].name, os_link_table[i].name) == 0) return OS_ERR_INVALID;
+			slot = (slot + 1) & (OS_SL_INDEX_SIZE - 1);
+		}
+
+		os_sl_index[slot] = (uint16_t)i;
+	}
+
+	os_sl_indexReady = true;
+	return OS_ERR_OK;
+}
+
+
 /***********************************************************************
  * OS shared library translate
  *
@@ -33,7 +104,23 @@ static void*  __used pOs_sl_translate = &os_sl_translate;
  **********************************************************************/
 void* os_sl_translate(char* name){
 
-	/* Search for function
+	/* Search the index. The table is at most half full, so a free slot always ends the probe
+	 ------------------------------------------------------*/
+	if(os_sl_indexReady){
+		uint32_t slot = os_sl_hash(name) & (OS_SL_INDEX_SIZE - 1);
+
+		while(os_sl_index[slot] != OS_SL_INDEX_EMPTY){
+			if(strcmp(os_link_table[os_sl_index[slot]].name, name) == 0){
+				return os_link_table[os_sl_index[slot]].fnPtr;
+			}
+
+			slot = (slot + 1) & (OS_SL_INDEX_SIZE - 1);
+		}
+
+		return NULL;
+	}
+
+	/* Index not built, search for function
 	 ------------------------------------------------------*/
 	for(size_t i = 0; i < os_sl_linkTable_getSize(); i++){
 
@@ -173,6 +173,17 @@ void SystemClock_Config(void)
 
 /* USER CODE BEGIN 4 */
 
+/* Stack guard report. Called in fault context : the UART is driven directly, without its mutex
+ ---------------------------------------------------*/
+void os_stack_overflow_cb(os_handle_t h){
+	os_task_t* t = (os_task_t*)h;
+	char const* name = h->name != NULL ? h->name : (t->process != NULL ? t->process->p_name : "No name");
+
+	char msg[64];
+	int len = snprintf(msg, sizeof(msg), "\r\nStack overflow in task %s\r\n", name);
+	HAL_UART_Transmit(&huart3, (uint8_t*)msg, (uint16_t)(len < (int)sizeof(msg) ? len : (int)sizeof(msg) - 1), 100);
+}
+
 /* USER CODE END 4 */
 
 /**
@@ -85,6 +85,7 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
+	os_scheduler_stackFault();
 
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
@@ -100,6 +101,7 @@ void HardFault_Handler(void)
 void MemManage_Handler(void)
 {
   /* USER CODE BEGIN MemoryManagement_IRQn 0 */
+	os_scheduler_stackFault();
 
   /* USER CODE END MemoryManagement_IRQn 0 */
   while (1)
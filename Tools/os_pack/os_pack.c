@@ -0,0 +1,417 @@
+/*
+ * os_pack.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Gabriel
+ *
+ *  Host tool converting a PIC ELF program into the packed image format loaded by os_process_create.
+ *  The image is pre-relocated against address 0: the kernel only adds its load address to the words
+ *  flagged in the relocation bitmap, and binds the imports by name.
+ *
+ *  The launch parameters come from the .os_manifest section of the program (see OS_MANIFEST), the options override them.
+ *
+ *  Build : gcc -O2 -o os_pack os_pack.c
+ *  Usage : os_pack [-s stack_size] [-p priority] [-m heap_size] program.elf program.img
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/**********************************************
+ * DEFINES
+ *********************************************/
+
+/* Must match OS_Process.h
+ ---------------------------------------------------*/
+#define OS_PACK_MAGIC				0x4B50534FUL
+#define OS_PACK_VERSION				2
+#define OS_MANIFEST_MAGIC			0x464D534FUL
+#define OS_MANIFEST_SECTION			".os_manifest"
+
+#define ELF_PT_LOAD					1
+#define ELF_PF_W					0x2
+#define ELF_SHT_REL					9
+#define ELF_SHF_ALLOC				0x2
+
+#define R_ARM_ABS32					2
+#define R_ARM_GLOB_DAT				21
+#define R_ARM_JUMP_SLOT				22
+#define R_ARM_RELATIVE				23
+
+/**********************************************
+ * PRIVATE TYPES
+ *********************************************/
+
+/* Must match os_manifest_t, os_pack_header_t and os_pack_import_t (OS_Process.h)
+ ---------------------------------------------------*/
+typedef struct __attribute__((packed)){
+	uint32_t	magic;
+	uint32_t	abiVersion;
+	uint32_t	stackSize;
+	uint32_t	heapSize;
+	int8_t		priority;
+	uint8_t		pad[3];
+} manifest_t;
+
+typedef struct __attribute__((packed)){
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	headerSize;
+	uint32_t	entry;
+	uint32_t	got;
+	uint32_t	textSize;
+	uint32_t	dataSize;
+	uint32_t	bssSize;
+	uint32_t	importNum;
+	manifest_t	manifest;
+} pack_header_t;
+
+typedef struct __attribute__((packed)){
+	uint32_t	offset;
+	uint32_t	nameLen;
+} pack_import_t;
+
+/* ELF 32 structures
+ ---------------------------------------------------*/
+typedef struct __attribute__((packed)){
+	uint8_t		e_ident[16];
+	uint16_t	e_type;
+	uint16_t	e_machine;
+	uint32_t	e_version;
+	uint32_t	e_entry;
+	uint32_t	e_phoff;
+	uint32_t	e_shoff;
+	uint32_t	e_flags;
+	uint16_t	e_ehsize;
+	uint16_t	e_phentsize;
+	uint16_t	e_phnum;
+	uint16_t	e_shentsize;
+	uint16_t	e_shnum;
+	uint16_t	e_shstrndx;
+} elf_header_t;
+
+typedef struct __attribute__((packed)){
+	uint32_t	p_type;
+	uint32_t	p_offset;
+	uint32_t	p_vaddr;
+	uint32_t	p_paddr;
+	uint32_t	p_filesz;
+	uint32_t	p_memsz;
+	uint32_t	p_flags;
+	uint32_t	p_align;
+} elf_ph_t;
+
+typedef struct __attribute__((packed)){
+	uint32_t	sh_name;
+	uint32_t	sh_type;
+	uint32_t	sh_flags;
+	uint32_t	sh_addr;
+	uint32_t	sh_offset;
+	uint32_t	sh_size;
+	uint32_t	sh_link;
+	uint32_t	sh_info;
+	uint32_t	sh_addralign;
+	uint32_t	sh_entsize;
+} elf_sh_t;
+
+typedef struct __attribute__((packed)){
+	uint32_t	r_offset;
+	uint32_t	r_info;
+} elf_rel_t;
+
+typedef struct __attribute__((packed)){
+	uint32_t	st_name;
+	uint32_t	st_value;
+	uint32_t	st_size;
+	uint8_t		st_info;
+	uint8_t		st_other;
+	uint16_t	st_shndx;
+} elf_sym_t;
+
+/* Import collected while relocating
+ ---------------------------------------------------*/
+typedef struct{
+	uint32_t	offset;
+	char const*	name;
+} import_t;
+
+/**********************************************
+ * PRIVATE VARIABLES
+ *********************************************/
+
+static uint8_t*		elf;			//Whole ELF file
+static size_t		elfSize;		//Size of the ELF file
+
+static uint8_t*		image;			//Image being built, text then data
+static uint32_t		imageSize;		//Size of the payload (text + data)
+static uint32_t		base;			//Lowest virtual address of the program
+static uint32_t*	bitmap;			//Relocation bitmap
+
+static import_t*	imports;		//Imports
+static uint32_t		importNum;		//Number of imports
+
+/**********************************************
+ * PRIVATE FUNCTIONS
+ *********************************************/
+
+static void fail(char const* msg){
+	fprintf(stderr, "os_pack: %s\n", msg);
+	exit(1);
+}
+
+static void* elf_at(uint32_t offset, uint32_t size){
+	if(offset > elfSize || size > elfSize - offset)
+		fail("truncated ELF file");
+
+	return &elf[offset];
+}
+
+static elf_sh_t* elf_section(elf_header_t* h, uint32_t index){
+	if(index >= h->e_shnum)
+		fail("bad section index");
+
+	return (elf_sh_t*)elf_at(h->e_shoff + index * h->e_shentsize, sizeof(elf_sh_t));
+}
+
+static uint32_t* image_word(uint32_t vaddr){
+	if(vaddr < base || vaddr - base + 4 > imageSize || ((vaddr - base) & 0x3) != 0)
+		fail("relocation outside of the payload");
+
+	return (uint32_t*)&image[vaddr - base];
+}
+
+static void image_rebase(uint32_t vaddr, uint32_t value){
+	uint32_t word = (vaddr - base) / 4;
+
+	*image_word(vaddr) = value - base;
+	bitmap[word / 32] |= 1UL << (word % 32);
+}
+
+static void image_import(uint32_t vaddr, uint32_t addend, char const* name){
+	*image_word(vaddr) = addend;
+
+	imports = realloc(imports, (importNum + 1) * sizeof(import_t));
+	if(imports == NULL)
+		fail("out of memory");
+
+	imports[importNum].offset = vaddr - base;
+	imports[importNum].name = name;
+	importNum++;
+}
+
+/* Apply a dynamic relocation section against address 0
+ ---------------------------------------------------*/
+static void relocate(elf_header_t* h, elf_sh_t* rel){
+	elf_sh_t* symtab = elf_section(h, rel->sh_link);
+	elf_sh_t* strtab = elf_section(h, symtab->sh_link);
+
+	elf_sym_t* syms = (elf_sym_t*)elf_at(symtab->sh_offset, symtab->sh_size);
+	char const* strs = (char const*)elf_at(strtab->sh_offset, strtab->sh_size);
+	uint32_t symNum = symtab->sh_size / sizeof(elf_sym_t);
+
+	elf_rel_t* r = (elf_rel_t*)elf_at(rel->sh_offset, rel->sh_size);
+	for(uint32_t i = 0; i < rel->sh_size / sizeof(elf_rel_t); i++){
+		uint32_t type = r[i].r_info & 0xFF;
+		uint32_t symIndex = r[i].r_info >> 8;
+
+		if(type == R_ARM_RELATIVE){
+			image_rebase(r[i].r_offset, *image_word(r[i].r_offset));
+			continue;
+		}
+
+		if(type != R_ARM_ABS32 && type != R_ARM_GLOB_DAT && type != R_ARM_JUMP_SLOT)
+			fail("unsupported relocation");
+
+		if(symIndex >= symNum || syms[symIndex].st_name >= strtab->sh_size)
+			fail("bad symbol");
+
+		elf_sym_t* sym = &syms[symIndex];
+		uint32_t addend = type == R_ARM_ABS32 ? *image_word(r[i].r_offset) : 0;
+
+		if(sym->st_shndx != 0)
+			image_rebase(r[i].r_offset, sym->st_value + addend);
+		else
+			image_import(r[i].r_offset, addend, &strs[sym->st_name]);
+	}
+}
+
+/**********************************************
+ * MAIN
+ *********************************************/
+
+int main(int argc, char* argv[]){
+
+	pack_header_t hdr;
+	memset(&hdr, 0, sizeof(hdr));
+
+	/* Arguments (applied over the manifest of the program)
+	 ------------------------------------------------------*/
+	manifest_t opts;
+	memset(&opts, 0, sizeof(opts));
+
+	int i = 1;
+	for(; i + 1 < argc && argv[i][0] == '-'; i += 2){
+		if(strcmp(argv[i], "-s") == 0)			opts.stackSize = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+		else if(strcmp(argv[i], "-p") == 0)		opts.priority = (int8_t)strtol(argv[i + 1], NULL, 0);
+		else if(strcmp(argv[i], "-m") == 0)		opts.heapSize = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+		else 									fail("unknown option");
+	}
+
+	if(argc - i != 2){
+		fprintf(stderr, "usage: os_pack [-s stack_size] [-p priority] [-m heap_size] program.elf program.img\n");
+		return 1;
+	}
+
+	/* Read the whole ELF file
+	 ------------------------------------------------------*/
+	FILE* in = fopen(argv[i], "rb");
+	if(in == NULL)
+		fail("cannot open input");
+
+	fseek(in, 0, SEEK_END);
+	elfSize = (size_t)ftell(in);
+	fseek(in, 0, SEEK_SET);
+
+	elf = malloc(elfSize);
+	if(elf == NULL || fread(elf, 1, elfSize, in) != elfSize)
+		fail("cannot read input");
+
+	fclose(in);
+
+	elf_header_t* h = (elf_header_t*)elf_at(0, sizeof(elf_header_t));
+	if(memcmp(h->e_ident, "\x7F" "ELF", 4) != 0 || h->e_ident[4] != 1 || h->e_ident[5] != 1 || h->e_machine != 40)
+		fail("not a 32 bit little endian ARM ELF file");
+
+	/* Layout: the text segments must come before the writable ones
+	 ------------------------------------------------------*/
+	uint32_t textEnd = 0, dataEnd = 0, memEnd = 0;
+	base = UINT32_MAX;
+
+	for(uint32_t j = 0; j < h->e_phnum; j++){
+		elf_ph_t* ph = (elf_ph_t*)elf_at(h->e_phoff + j * h->e_phentsize, sizeof(elf_ph_t));
+		if(ph->p_type != ELF_PT_LOAD)
+			continue;
+
+		if(ph->p_vaddr < base)
+			base = ph->p_vaddr;
+
+		if((ph->p_flags & ELF_PF_W) == 0){
+			if(dataEnd != 0 || ph->p_filesz != ph->p_memsz)
+				fail("read only segments must come first and have no zero filled memory");
+
+			textEnd = ph->p_vaddr + ph->p_filesz;
+		}
+		else if(ph->p_vaddr + ph->p_filesz > dataEnd)
+			dataEnd = ph->p_vaddr + ph->p_filesz;
+
+		if(ph->p_vaddr + ph->p_memsz > memEnd)
+			memEnd = ph->p_vaddr + ph->p_memsz;
+	}
+
+	if(base == UINT32_MAX)
+		fail("no LOAD segment");
+
+	hdr.textSize = (textEnd > base ? textEnd - base + 3 : 0) & ~(uint32_t)0x3;
+	imageSize = dataEnd > base + hdr.textSize ? (dataEnd - base + 3) & ~(uint32_t)0x3 : hdr.textSize;
+	hdr.dataSize = imageSize - hdr.textSize;
+	hdr.bssSize = memEnd - base > imageSize ? memEnd - base - imageSize : 0;
+
+	/* Copy the segments, gaps are zero filled
+	 ------------------------------------------------------*/
+	image = calloc(1, imageSize + 4);
+	bitmap = calloc(1, ((imageSize / 4 + 31) / 32) * 4 + 4);
+	if(image == NULL || bitmap == NULL)
+		fail("out of memory");
+
+	for(uint32_t j = 0; j < h->e_phnum; j++){
+		elf_ph_t* ph = (elf_ph_t*)elf_at(h->e_phoff + j * h->e_phentsize, sizeof(elf_ph_t));
+		if(ph->p_type == ELF_PT_LOAD && ph->p_filesz > 0)
+			memcpy(&image[ph->p_vaddr - base], elf_at(ph->p_offset, ph->p_filesz), ph->p_filesz);
+	}
+
+	/* Relocations, or the sections the kernel rebases by name when there are none
+	 ------------------------------------------------------*/
+	elf_sh_t* names = elf_section(h, h->e_shstrndx);
+	char const* shstr = (char const*)elf_at(names->sh_offset, names->sh_size);
+	int dynRel = 0;
+
+	for(uint32_t j = 0; j < h->e_shnum; j++){
+		elf_sh_t* sh = elf_section(h, j);
+		if(sh->sh_type == ELF_SHT_REL && (sh->sh_flags & ELF_SHF_ALLOC) != 0){
+			relocate(h, sh);
+			dynRel = 1;
+		}
+	}
+
+	for(uint32_t j = 0; j < h->e_shnum; j++){
+		elf_sh_t* sh = elf_section(h, j);
+		if(sh->sh_name >= names->sh_size)
+			continue;
+
+		char const* name = &shstr[sh->sh_name];
+		if(strcmp(name, ".got") == 0)
+			hdr.got = sh->sh_addr - base;
+
+		if(strcmp(name, OS_MANIFEST_SECTION) == 0){
+			if(sh->sh_size < sizeof(manifest_t))
+				fail("truncated manifest");
+
+			memcpy(&hdr.manifest, elf_at(sh->sh_offset, sizeof(manifest_t)), sizeof(manifest_t));
+			if(hdr.manifest.magic != OS_MANIFEST_MAGIC)
+				fail("bad manifest");
+		}
+
+		if(dynRel)
+			continue;
+
+		if(strcmp(name, ".got") != 0 && strcmp(name, ".preinit_array") != 0 && strcmp(name, ".init_array") != 0 && strcmp(name, ".fini_array") != 0)
+			continue;
+
+		for(uint32_t k = 0; k < sh->sh_size; k += 4)
+			image_rebase(sh->sh_addr + k, *image_word(sh->sh_addr + k));
+	}
+
+	/* Header
+	 ------------------------------------------------------*/
+	hdr.magic = OS_PACK_MAGIC;
+	hdr.version = OS_PACK_VERSION;
+	hdr.headerSize = sizeof(hdr);
+	hdr.entry = (h->e_entry & ~(uint32_t)0x1) - base;
+	hdr.importNum = importNum;
+
+	hdr.manifest.magic = OS_MANIFEST_MAGIC;
+	if(opts.stackSize != 0)		hdr.manifest.stackSize = opts.stackSize;
+	if(opts.heapSize != 0)		hdr.manifest.heapSize = opts.heapSize;
+	if(opts.priority != 0)		hdr.manifest.priority = opts.priority;
+
+	if(hdr.entry >= imageSize)
+		fail("entry point outside of the payload");
+
+	/* Write header, bitmap, payload and imports
+	 ------------------------------------------------------*/
+	FILE* out = fopen(argv[i + 1], "wb");
+	if(out == NULL)
+		fail("cannot open output");
+
+	fwrite(&hdr, sizeof(hdr), 1, out);
+	fwrite(bitmap, 4, (imageSize / 4 + 31) / 32, out);
+	fwrite(image, 1, imageSize, out);
+
+	for(uint32_t j = 0; j < importNum; j++){
+		static uint8_t const zeros[4];
+		pack_import_t imp = { imports[j].offset, (uint32_t)strlen(imports[j].name) };
+
+		fwrite(&imp, sizeof(imp), 1, out);
+		fwrite(imports[j].name, 1, imp.nameLen, out);
+		fwrite(zeros, 1, ((imp.nameLen + 3) & ~0x3UL) - imp.nameLen, out);
+	}
+
+	if(fclose(out) != 0)
+		fail("cannot write output");
+
+	printf("%s: text %u, data %u, bss %u, %u imports, stack %u, heap %u, priority %d\n", argv[i + 1], hdr.textSize, hdr.dataSize, hdr.bssSize, importNum,
+			hdr.manifest.stackSize, hdr.manifest.heapSize, hdr.manifest.priority);
+	return 0;
+}